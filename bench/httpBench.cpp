@@ -0,0 +1,59 @@
+//
+// Repeat-lookup latency through httpSession versus a fresh cpr::Get per request.
+// Point it at a local server so the numbers are not dominated by the internet.
+//
+// Usage: HttpBench <url> [requests = 200]
+//
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "httpSession.h"
+
+using benchClock = std::chrono::steady_clock;
+
+static void printTotals(const char* label, const httpSessionStats& totals) {
+    double n = totals.requests > 0 ? static_cast<double>(totals.requests) : 1.0;
+
+    std::cout << label << " (" << totals.requests << " requests, " << totals.reusedConnections << " reused)\n"
+              << "  dns      " << totals.dnsMs / n << " ms\n"
+              << "  connect  " << totals.connectMs / n << " ms\n"
+              << "  tls      " << totals.tlsMs / n << " ms\n"
+              << "  ttfb     " << totals.ttfbMs / n << " ms\n"
+              << "  transfer " << totals.transferMs / n << " ms\n"
+              << "  total    " << totals.totalMs / n << " ms\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <url> [requests]\n";
+        return 1;
+    }
+
+    std::string url = argv[1];
+    int requests = argc > 2 ? std::stoi(argv[2]) : 200;
+
+    // Baseline: a new handle, connection and handshake every time
+    auto start = benchClock::now();
+    for (int i = 0; i < requests; ++i) {
+        cpr::Response r = cpr::Get(cpr::Url{url});
+        if (r.error) {
+            std::cerr << "Request failed: " << r.error.message << "\n";
+            return 1;
+        }
+    }
+    double freshMs = std::chrono::duration<double, std::milli>(benchClock::now() - start).count() / requests;
+
+    httpSession::resetTotals();
+    start = benchClock::now();
+    for (int i = 0; i < requests; ++i) {
+        httpSession::forThisThread().get(url);
+    }
+    double sessionMs = std::chrono::duration<double, std::milli>(benchClock::now() - start).count() / requests;
+
+    std::cout << "fresh cpr::Get:  " << freshMs << " ms per request\n"
+              << "httpSession:     " << sessionMs << " ms per request\n";
+    printTotals("httpSession phases", httpSession::totals());
+    return 0;
+}
@@ -0,0 +1,107 @@
+//
+// Import and lookup cost of the offline lexicon on a synthetic corpus.
+//
+// Usage: LexiconBench [headwordCount = 500000]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lexicon.h"
+
+using benchClock = std::chrono::steady_clock;
+
+static double secondsSince(benchClock::time_point start) {
+    return std::chrono::duration<double>(benchClock::now() - start).count();
+}
+
+// Pronounceable pseudo-words so keys share prefixes the way real headwords do
+static std::string makeHeadword(std::mt19937& rng) {
+    static const char* syllables[] = {"ab", "ac", "al", "an", "ar", "be", "ca", "co", "de", "di", "el", "en",
+                                      "er", "ex", "fa", "ge", "in", "is", "la", "le", "ma", "mi", "ne", "no",
+                                      "or", "pa", "pe", "ra", "re", "ri", "sa", "se", "st", "ta", "ti", "to",
+                                      "un", "ur", "ve", "vi"};
+    std::uniform_int_distribution<int> syllable(0, 39);
+    std::uniform_int_distribution<int> length(2, 5);
+
+    std::string word;
+    for (int i = length(rng); i > 0; --i) word += syllables[syllable(rng)];
+    return word;
+}
+
+int main(int argc, char** argv) {
+    size_t headwords = argc > 1 ? std::stoul(argv[1]) : 500000;
+
+    auto dir = std::filesystem::temp_directory_path() / "lexicon_bench";
+    std::filesystem::create_directories(dir);
+    std::string dumpPath = (dir / "corpus.ndjson").string();
+    std::string lexiconPath = (dir / "corpus.lex").string();
+
+    std::mt19937 rng(42);
+    std::vector<std::string> words;
+    words.reserve(headwords);
+
+    {
+        std::ofstream dump(dumpPath, std::ios::binary);
+        for (size_t i = 0; i < headwords; ++i) {
+            std::string word = makeHeadword(rng) + std::to_string(i);
+            words.push_back(word);
+
+            dump << R"([{"word":")" << word << R"(","phonetic":"/)" << word << R"(/","meanings":[)"
+                 << R"({"partOfSpeech":"noun","definitions":[{"definition":"A synthetic noun sense of )" << word
+                 << R"(."},{"definition":"Another, somewhat longer synthetic definition used for sizing."}]},)"
+                 << R"({"partOfSpeech":"verb","definitions":[{"definition":"To do what )" << word
+                 << R"( does."}]}]}])" << '\n';
+        }
+    }
+
+    auto importStart = benchClock::now();
+    lexiconBuilder builder;
+    builder.importDump(dumpPath);
+    double parseSeconds = secondsSince(importStart);
+    builder.write(lexiconPath);
+    double importSeconds = secondsSince(importStart);
+
+    auto openStart = benchClock::now();
+    lexicon offline;
+    if (!offline.open(lexiconPath)) {
+        std::cerr << "Cannot open " << lexiconPath << "\n";
+        return 1;
+    }
+    double openSeconds = secondsSince(openStart);
+
+    std::shuffle(words.begin(), words.end(), rng);
+    const size_t lookups = std::min<size_t>(words.size(), 200000);
+
+    size_t found = 0;
+    auto hitStart = benchClock::now();
+    for (size_t i = 0; i < lookups; ++i) {
+        if (offline.find(normalizeWord(words[i]))) found++;
+    }
+    double hitSeconds = secondsSince(hitStart);
+
+    size_t missed = 0;
+    auto missStart = benchClock::now();
+    for (size_t i = 0; i < lookups; ++i) {
+        if (!offline.find(words[i] + "zz")) missed++;
+    }
+    double missSeconds = secondsSince(missStart);
+
+    std::cout << "headwords:        " << offline.size() << "\n"
+              << "lexicon size:     " << std::filesystem::file_size(lexiconPath) / (1024 * 1024) << " MiB\n"
+              << "import (parse):   " << parseSeconds << " s\n"
+              << "import (total):   " << importSeconds << " s\n"
+              << "open + mmap:      " << openSeconds * 1e6 << " us\n"
+              << "hit lookup:       " << hitSeconds / static_cast<double>(lookups) * 1e9 << " ns (" << found << "/" << lookups << " found)\n"
+              << "miss lookup:      " << missSeconds / static_cast<double>(lookups) * 1e9 << " ns (" << missed << "/" << lookups << " missed)\n";
+
+    offline.close();
+    std::filesystem::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,134 @@
+//
+// Text measurement cost of laying out a 200-definition word, raw MeasureTextEx
+// versus the shared TextMeasure cache. The wrap loop is the one TextElement
+// runs for every definition.
+//
+// Usage: MeasureBench [font.ttf] [definitions = 200] [rounds = 20]
+//
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <raylib.h>
+
+#include "textMeasure.h"
+#include "ui.h"
+
+using benchClock = std::chrono::steady_clock;
+
+constexpr int FONT_SIZE = 24;
+constexpr float SPACING = 1.0f;
+constexpr float WRAP_LENGTH = 1400.0f;
+
+static std::vector<std::string> makeDefinitions(size_t count) {
+    static const char* words[] = {"the", "of", "a", "to", "move", "swiftly", "quality", "condition", "person",
+                                  "especially", "something", "relating", "manner", "used", "which", "state",
+                                  "being", "pronounced", "informal", "archaic", "derived", "sense", "figurative",
+                                  "characterized", "by", "or", "in", "an", "act", "instance"};
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> word(0, 29);
+    std::uniform_int_distribution<int> length(8, 60);
+
+    std::vector<std::string> definitions;
+    for (size_t i = 0; i < count; ++i) {
+        std::string text;
+        for (int w = length(rng); w > 0; --w) {
+            if (!text.empty()) text += ' ';
+            text += words[word(rng)];
+        }
+        definitions.push_back(text + ".");
+    }
+    return definitions;
+}
+
+// TextElement::wrap_text before the cache: every probe is a full MeasureTextEx
+static size_t wrapRaw(const Font& font, const std::string& text) {
+    std::istringstream words(text);
+    std::string word;
+    std::string currentLine;
+    std::vector<std::string> lines;
+    float width = 0.0f;
+
+    auto measure = [&](const std::string& line) {
+        return MeasureTextEx(font, line.c_str(), static_cast<float>(FONT_SIZE), SPACING).x;
+    };
+
+    while (words >> word) {
+        std::string testLine = currentLine.empty() ? word : currentLine + " " + word;
+        if (measure(testLine) <= WRAP_LENGTH || currentLine.empty()) {
+            currentLine = testLine;
+        }
+        else {
+            lines.push_back(currentLine);
+            width = std::max(width, measure(currentLine));
+            currentLine = word;
+
+            if (measure(currentLine) > WRAP_LENGTH) {
+                lines.push_back(currentLine);
+                width = std::max(width, measure(currentLine));
+                currentLine.clear();
+            }
+        }
+    }
+    if (!currentLine.empty()) {
+        lines.push_back(currentLine);
+        width = std::max(width, measure(currentLine));
+    }
+    return lines.size();
+}
+
+static size_t wrapCached(const Font& font, const std::string& text) {
+    TextElement element(text, FONT_SIZE, WHITE, font);
+    element.useWrapText = true;
+    element.wrapLength = WRAP_LENGTH;
+    element.wrap_text();
+    return element.lines.size();
+}
+
+template <typename Wrap>
+static double timeLayout(const Font& font, const std::vector<std::string>& definitions, int rounds, Wrap wrap) {
+    size_t lines = 0;
+    auto start = benchClock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& definition : definitions) lines += wrap(font, definition);
+    }
+    double seconds = std::chrono::duration<double>(benchClock::now() - start).count();
+    if (lines == 0) std::cerr << "no lines laid out\n";
+    return seconds * 1000.0 / rounds;
+}
+
+int main(int argc, char** argv) {
+    const char* fontPath = argc > 1 ? argv[1] : nullptr;
+    size_t count = argc > 2 ? std::stoul(argv[2]) : 200;
+    int rounds = argc > 3 ? std::stoi(argv[3]) : 20;
+
+    // Fonts need a GL context
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "MeasureBench");
+
+    Font font = fontPath ? LoadFontEx(fontPath, FONT_SIZE, nullptr, 0) : GetFontDefault();
+    std::vector<std::string> definitions = makeDefinitions(count);
+
+    double raw = timeLayout(font, definitions, rounds, wrapRaw);
+
+    TextMeasure::clear();
+    TextMeasure::resetStats();
+    double cold = timeLayout(font, definitions, 1, wrapCached);
+    double warm = timeLayout(font, definitions, rounds, wrapCached);
+    TextMeasureStats stats = TextMeasure::stats();
+
+    std::cout << count << " definitions, " << (fontPath ? fontPath : "default font") << "\n"
+              << "  MeasureTextEx   " << raw << " ms per layout\n"
+              << "  cache, cold     " << cold << " ms (" << raw / cold << "x)\n"
+              << "  cache, warm     " << warm << " ms (" << raw / warm << "x)\n"
+              << "  hit rate        " << stats.hitRate() * 100.0 << "% of " << stats.hits + stats.misses
+              << " lookups, " << stats.glyphMisses << " glyph lookups, " << stats.cachedStrings << " strings cached\n";
+
+    if (fontPath) UnloadFont(font);
+    CloseWindow();
+    return 0;
+}
@@ -0,0 +1,140 @@
+//
+// DOM versus SAX parsing of API responses. Every fixture, plus a few malformed
+// and oddly shaped bodies, must produce the same WordData from both backends
+// before anything is timed.
+//
+// Usage: ParserBench [fixtureDir = fixtures/responses] [iterations = 20000]
+//
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fetcher.h"
+#include "saxExtractor.h"
+
+#ifndef DICTIONARY_FIXTURES_DIR
+#define DICTIONARY_FIXTURES_DIR "fixtures/responses"
+#endif
+
+using benchClock = std::chrono::steady_clock;
+
+// Keeps the optimizer from discarding parses whose results are never read
+static volatile size_t benchSink;
+
+struct sample {
+    std::string name;
+    std::string body;
+};
+
+static bool sameWordData(const WordData& a, const WordData& b) {
+    return a.word == b.word && a.phonetic == b.phonetic && a.posList == b.posList &&
+           a.definitionList == b.definitionList;
+}
+
+// Shapes the real API never sends but the parsers must still agree on
+static std::vector<sample> edgeCases() {
+    return {
+        {"empty array", "[]"},
+        {"top-level object", R"({"title":"No Definitions Found"})"},
+        {"scalar entry", R"([1, {"word":"second"}])"},
+        {"truncated", R"([{"word":"cut","meanings":[{"partOfSpeech":"noun")"},
+        {"not json", "<html>502 Bad Gateway</html>"},
+        {"phonetics fallback", R"([{"word":"a","phonetics":[{"text":""},{"audio":"x"},{"text":"/b/"},{"text":"/c/"}]}])"},
+        {"all empty phonetics", R"([{"word":"a","phonetics":[{"text":""},{"text":""}]}])"},
+        {"phonetics object", R"([{"word":"a","phonetics":{"uk":{"text":"/uk/"}}}])"},
+        {"non-string phonetic", R"([{"word":"a","phonetic":7,"phonetics":[{"text":"/p/"}]}])"},
+        {"duplicate keys", R"([{"word":"a","word":"b","meanings":[{"partOfSpeech":"noun","definitions":[{"definition":"x"}]}],)"
+                           R"("meanings":[{"partOfSpeech":"verb","partOfSpeech":3,"definitions":[{"definition":"y","definition":"z"}]}]}])"},
+        {"meanings object", R"([{"word":"a","meanings":{"partOfSpeech":"noun"}}])"},
+        {"nested noise", R"([{"word":"a","extra":{"word":"no","meanings":[]},"meanings":[{"definitions":[{"definition":"d",)"
+                         R"("synonyms":[{"definition":"no"}]},"skip",{"definition":null}],"partOfSpeech":"adj"},[],null]}])"},
+    };
+}
+
+static std::vector<sample> loadFixtures(const std::filesystem::path& dir) {
+    std::vector<sample> samples;
+    std::error_code ec;
+    for (const auto& file : std::filesystem::directory_iterator(dir, ec)) {
+        if (file.path().extension() != ".json") continue;
+
+        std::ifstream in(file.path(), std::ios::binary);
+        std::ostringstream body;
+        body << in.rdbuf();
+        samples.push_back({file.path().filename().string(), body.str()});
+    }
+    return samples;
+}
+
+template <typename Parse>
+static double timeParser(const std::vector<sample>& samples, int iterations, Parse parse) {
+    size_t sink = 0;
+    auto start = benchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (const auto& s : samples) {
+            WordData data;
+            parse(s.body, data);
+            sink += data.definitionList.size();
+        }
+    }
+    double seconds = std::chrono::duration<double>(benchClock::now() - start).count();
+    benchSink = sink;
+    return seconds;
+}
+
+int main(int argc, char** argv) {
+    std::filesystem::path dir = argc > 1 ? argv[1] : DICTIONARY_FIXTURES_DIR;
+    int iterations = argc > 2 ? std::stoi(argv[2]) : 20000;
+
+    std::vector<sample> fixtures = loadFixtures(dir);
+    if (fixtures.empty()) {
+        std::cerr << "No .json fixtures found in " << dir.string() << "\n";
+        return 1;
+    }
+
+    // Parse errors are expected for the malformed cases
+    std::streambuf* errBuf = std::cerr.rdbuf(nullptr);
+
+    int mismatches = 0;
+    std::vector<sample> checked = fixtures;
+    for (auto& edge : edgeCases()) checked.push_back(edge);
+
+    for (const auto& s : checked) {
+        WordData dom, sax;
+        bool domOk = parseWordDataDom(s.body, dom);
+        bool saxOk = parseWordDataSax(s.body, sax);
+        if (domOk != saxOk || !sameWordData(dom, sax)) {
+            std::cout << "MISMATCH " << s.name << "\n"
+                      << "  dom: " << dom.word << " " << dom.phonetic << " pos=" << dom.posList.size()
+                      << " defs=" << dom.definitionList.size() << "\n"
+                      << "  sax: " << sax.word << " " << sax.phonetic << " pos=" << sax.posList.size()
+                      << " defs=" << sax.definitionList.size() << "\n";
+            ++mismatches;
+        }
+    }
+
+    std::cerr.rdbuf(errBuf);
+
+    std::cout << checked.size() << " bodies checked, " << mismatches << " mismatches\n";
+    if (mismatches > 0) return 1;
+
+    size_t bytes = 0;
+    for (const auto& s : fixtures) bytes += s.body.size();
+    double totalBytes = static_cast<double>(bytes) * iterations;
+    double parses = static_cast<double>(fixtures.size()) * iterations;
+
+    double domSeconds = timeParser(fixtures, iterations, parseWordDataDom);
+    double saxSeconds = timeParser(fixtures, iterations, parseWordDataSax);
+
+    std::cout << fixtures.size() << " fixtures, " << bytes << " bytes, " << iterations << " iterations\n"
+              << "  dom " << domSeconds * 1e6 / parses << " us/parse, " << totalBytes / domSeconds / (1 << 20)
+              << " MiB/s\n"
+              << "  sax " << saxSeconds * 1e6 / parses << " us/parse, " << totalBytes / saxSeconds / (1 << 20)
+              << " MiB/s\n"
+              << "  speedup " << domSeconds / saxSeconds << "x\n";
+    return 0;
+}
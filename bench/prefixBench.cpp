@@ -0,0 +1,62 @@
+//
+// Build time, memory and top-k query latency of the autocomplete trie.
+//
+// Usage: PrefixBench [headwordCount = 500000]
+//
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "prefixIndex.h"
+
+using benchClock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    size_t headwords = argc > 1 ? std::stoul(argv[1]) : 500000;
+
+    static const char* syllables[] = {"ab", "ac", "al", "an", "ar", "be", "ca", "co", "de", "di", "el", "en",
+                                      "er", "ex", "fa", "ge", "in", "is", "la", "le", "ma", "mi", "ne", "no",
+                                      "or", "pa", "pe", "ra", "re", "ri", "sa", "se", "st", "ta", "ti", "to",
+                                      "un", "ur", "ve", "vi"};
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> syllable(0, 39);
+    std::uniform_int_distribution<int> length(2, 6);
+    std::uniform_int_distribution<uint32_t> frequency(0, 100000);
+
+    std::vector<prefixIndex::headword> words;
+    words.reserve(headwords);
+    while (words.size() < headwords) {
+        std::string word;
+        for (int i = length(rng); i > 0; --i) word += syllables[syllable(rng)];
+        words.push_back({std::move(word), frequency(rng)});
+    }
+
+    auto buildStart = benchClock::now();
+    prefixIndex index;
+    index.build(words);
+    double buildMs = std::chrono::duration<double, std::milli>(benchClock::now() - buildStart).count();
+
+    std::cout << "headwords:   " << index.size() << " unique\n"
+              << "trie nodes:  " << index.nodeCount() << "\n"
+              << "memory:      " << index.memoryBytes() / 1024 << " KiB\n"
+              << "build:       " << buildMs << " ms\n";
+
+    const char* prefixes[] = {"a", "re", "sta", "conta", "vivivi", "zz"};
+    const int iterations = 20000;
+
+    for (const char* prefix : prefixes) {
+        size_t returned = 0;
+        auto start = benchClock::now();
+        for (int i = 0; i < iterations; ++i) {
+            returned += index.complete(prefix, 8).size();
+        }
+        double us = std::chrono::duration<double, std::micro>(benchClock::now() - start).count() / iterations;
+
+        std::cout << "top-8 \"" << prefix << "\": " << us << " us (" << returned / iterations << " results)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+//
+// singleFlight under contention: many threads asking for a handful of keys at
+// once, the way the batch tool, the lookup worker and a prefetch can all
+// want the same word. Each round releases every thread together; the work
+// function stands in for a network round trip.
+//
+// Checks as it goes: every caller gets the value for its own key, every call
+// is counted exactly once as started or coalesced, overlapping calls start
+// the work only once per key, an exception reaches every waiter, and nothing
+// is left in flight at the end. Exits non-zero on the first failed check.
+//
+// Usage: SingleFlightBench [threads = 64] [keys = 4] [rounds = 200] [work us = 500]
+//
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "singleFlight.h"
+
+using benchClock = std::chrono::steady_clock;
+
+struct roundResult {
+    size_t calls{0};
+    size_t wrongValues{0};
+    size_t exceptions{0};
+    double seconds{0.0};
+};
+
+// All threads start on the same signal, then each asks for key (thread % keys)
+template <typename Call>
+static roundResult runRound(size_t threads, size_t keys, Call call) {
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<size_t> wrong{0};
+    std::atomic<size_t> thrown{0};
+
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            std::string key = "word" + std::to_string(t % keys);
+            ready++;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            try {
+                if (call(key) != key) wrong++;
+            }
+            catch (const std::runtime_error&) {
+                thrown++;
+            }
+        });
+    }
+
+    while (ready.load() < threads) std::this_thread::yield();
+    auto start = benchClock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : pool) thread.join();
+
+    return {threads, wrong.load(), thrown.load(), std::chrono::duration<double>(benchClock::now() - start).count()};
+}
+
+static int fail(const std::string& what) {
+    std::cerr << "FAILED: " << what << "\n";
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    size_t threads = argc > 1 ? std::stoul(argv[1]) : 64;
+    size_t keys = argc > 2 ? std::stoul(argv[2]) : 4;
+    int rounds = argc > 3 ? std::stoi(argv[3]) : 200;
+    auto work = std::chrono::microseconds(argc > 4 ? std::stoi(argv[4]) : 500);
+
+    std::atomic<size_t> executions{0};
+    auto slowLookup = [&](const std::string& key) {
+        executions++;
+        std::this_thread::sleep_for(work);
+        return key;
+    };
+
+    // Baseline: every caller does its own round trip
+    executions = 0;
+    double direct = 0.0;
+    for (int r = 0; r < rounds; ++r) direct += runRound(threads, keys, slowLookup).seconds;
+    size_t directExecutions = executions.load();
+
+    singleFlight<std::string> flights;
+    executions = 0;
+    double coalesced = 0.0;
+    size_t calls = 0;
+    for (int r = 0; r < rounds; ++r) {
+        roundResult result = runRound(threads, keys, [&](const std::string& key) {
+            return flights.run(key, [&]() { return slowLookup(key); });
+        });
+        if (result.wrongValues > 0) return fail(std::to_string(result.wrongValues) + " callers got another key's value");
+        coalesced += result.seconds;
+        calls += result.calls;
+    }
+
+    singleFlightStats stats = flights.stats();
+    if (stats.started + stats.coalesced != calls) {
+        return fail(std::to_string(calls) + " calls but " + std::to_string(stats.started) + " started + " +
+                    std::to_string(stats.coalesced) + " coalesced");
+    }
+    if (stats.started != executions.load()) return fail("work ran outside a started flight");
+    if (stats.inFlight != 0) return fail(std::to_string(stats.inFlight) + " keys still in flight");
+
+    // Work that outlasts the thread start-up spread: one execution per key, no more
+    executions = 0;
+    singleFlight<std::string> longFlights;
+    roundResult slow = runRound(threads, keys, [&](const std::string& key) {
+        return longFlights.run(key, [&]() {
+            executions++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            return key;
+        });
+    });
+    if (slow.wrongValues > 0 || executions.load() != keys) {
+        return fail("overlapping calls ran the work " + std::to_string(executions.load()) + " times for " +
+                    std::to_string(keys) + " keys");
+    }
+
+    // A failed lookup fails every caller that was waiting on it
+    singleFlight<std::string> failing;
+    roundResult thrown = runRound(threads, keys, [&](const std::string& key) -> std::string {
+        return failing.run(key, [&]() -> std::string {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            throw std::runtime_error("lookup failed");
+        });
+    });
+    if (thrown.exceptions != threads) {
+        return fail(std::to_string(thrown.exceptions) + " of " + std::to_string(threads) + " callers saw the exception");
+    }
+    if (failing.stats().inFlight != 0) return fail("a failed flight was left in flight");
+
+    std::cout << threads << " threads, " << keys << " keys, " << rounds << " rounds, " << work.count()
+              << " us per lookup\n"
+              << "  direct        " << direct * 1000.0 / rounds << " ms per round, " << directExecutions
+              << " lookups\n"
+              << "  single flight " << coalesced * 1000.0 / rounds << " ms per round, " << stats.started
+              << " lookups, " << stats.coalesced << " coalesced ("
+              << 100.0 * static_cast<double>(stats.coalesced) / static_cast<double>(calls) << "%)\n";
+    return 0;
+}
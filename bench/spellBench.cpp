@@ -0,0 +1,71 @@
+//
+// Build cost and correction latency of the "did you mean" index.
+//
+// Usage: SpellBench [headwordCount = 500000]
+//
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "prefixIndex.h"
+#include "spellIndex.h"
+
+using benchClock = std::chrono::steady_clock;
+
+int main(int argc, char** argv) {
+    size_t headwords = argc > 1 ? std::stoul(argv[1]) : 500000;
+
+    static const char* syllables[] = {"ab", "ac", "al", "an", "ar", "be", "ca", "co", "de", "di", "el", "en",
+                                      "er", "ex", "fa", "ge", "in", "is", "la", "le", "ma", "mi", "ne", "no",
+                                      "or", "pa", "pe", "ra", "re", "ri", "sa", "se", "st", "ta", "ti", "to",
+                                      "un", "ur", "ve", "vi"};
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> syllable(0, 39);
+    std::uniform_int_distribution<int> length(2, 6);
+
+    std::vector<prefixIndex::headword> words;
+    words.reserve(headwords);
+    while (words.size() < headwords) {
+        std::string word;
+        for (int i = length(rng); i > 0; --i) word += syllables[syllable(rng)];
+        words.push_back({std::move(word), 0});
+    }
+
+    prefixIndex ranked;
+    ranked.build(words);
+
+    auto buildStart = benchClock::now();
+    spellIndex spell;
+    spell.build(ranked.headwords());
+    double buildMs = std::chrono::duration<double, std::milli>(benchClock::now() - buildStart).count();
+
+    // One deletion plus one substitution, i.e. distance 2 from a real headword
+    std::vector<std::string> queries;
+    for (int i = 0; i < 5000; ++i) {
+        std::string word = ranked.headwords()[rng() % ranked.size()];
+        if (word.size() > 3) {
+            word.erase(rng() % word.size(), 1);
+            word[rng() % word.size()] = 'q';
+        }
+        queries.push_back(word);
+    }
+
+    size_t returned = 0;
+    auto start = benchClock::now();
+    for (const auto& query : queries) {
+        returned += spell.lookup(query).size();
+    }
+    double us = std::chrono::duration<double, std::micro>(benchClock::now() - start).count() /
+                static_cast<double>(queries.size());
+
+    std::cout << "headwords:   " << spell.size() << " unique\n"
+              << "memory:      " << spell.memoryBytes() / 1024 << " KiB\n"
+              << "build:       " << buildMs << " ms\n"
+              << "lookup:      " << us << " us (" << static_cast<double>(returned) / static_cast<double>(queries.size())
+              << " corrections per query)\n";
+    return 0;
+}
@@ -0,0 +1,278 @@
+//
+// Headless cost of the real screens: dataScreen built from synthetic WordData
+// with 10 to 10,000 definitions, plus searchScreen, in a hidden window.
+//
+// Per screen and size, the median over rounds of:
+//   build   showWordData() / onEnter(): font acquisition and buildUI
+//   layout  the first update() after building, which lays the tree out
+//   update  a steady-state update() with nothing changing
+//   draw    a steady-state draw() call, CPU side only
+//   frame   BeginDrawing() to EndDrawing() around it, including the flush
+// and, separately, TextElement::wrap_text over every definition at the
+// definition width (the screen itself only wraps what scrolls into view).
+//
+// Results go to stdout and, with --json, to a file for comparing builds.
+//
+// Usage: UiBench [--json results.json] [--rounds 5] [--font font.ttf] [--sizes 10,100,1000,10000]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <raylib.h>
+
+#include "dataScreen.h"
+#include "searchScreen.h"
+#include "fontManager.h"
+#include "ui.h"
+
+using benchClock = std::chrono::steady_clock;
+
+constexpr float SCREEN_WIDTH = 1920.0f;
+constexpr float SCREEN_HEIGHT = 1080.0f;
+constexpr int STEADY_FRAMES = 20;
+
+// Same as dataScreen's definitions
+constexpr int DEFINITION_FONT_SIZE = 24;
+constexpr float DEFINITION_WIDTH = SCREEN_WIDTH - 160.0f;
+
+static const char* WORDS[] = {"the", "of", "a", "to", "move", "swiftly", "quality", "condition", "person",
+                              "especially", "something", "relating", "manner", "used", "which", "state",
+                              "being", "pronounced", "informal", "archaic", "derived", "sense", "figurative",
+                              "characterized", "by", "or", "in", "an", "act", "instance"};
+
+static WordData makeWordData(size_t definitions) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> word(0, 29);
+    std::uniform_int_distribution<int> length(8, 60);
+
+    WordData data;
+    data.word = "benchmark";
+    data.phonetic = "/ˈbɛntʃmɑːk/";
+    data.posList = {"noun", "verb"};
+    for (size_t i = 0; i < definitions; ++i) {
+        std::string text;
+        for (int w = length(rng); w > 0; --w) {
+            if (!text.empty()) text += ' ';
+            text += WORDS[word(rng)];
+        }
+        data.definitionList.push_back(text + ".");
+    }
+    return data;
+}
+
+static double msSince(benchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(benchClock::now() - start).count();
+}
+
+static double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+struct screenSample {
+    double build = 0.0;
+    double layout = 0.0;
+    double update = 0.0;
+    double draw = 0.0;
+    double frame = 0.0;
+    int layoutPasses = 0; // in a steady frame, should be 0
+    int draws = 0;
+    int cacheRenders = 0;
+};
+
+struct screenResult {
+    std::string screen;
+    size_t definitions = 0;
+    std::vector<screenSample> rounds;
+
+    [[nodiscard]] nlohmann::json toJson() const {
+        auto medianOf = [&](double screenSample::*field) {
+            std::vector<double> values;
+            for (const auto& sample : rounds) values.push_back(sample.*field);
+            return median(values);
+        };
+        const screenSample& last = rounds.back();
+        return {
+            {"screen", screen},
+            {"definitions", definitions},
+            {"buildMs", medianOf(&screenSample::build)},
+            {"layoutMs", medianOf(&screenSample::layout)},
+            {"updateMs", medianOf(&screenSample::update)},
+            {"drawMs", medianOf(&screenSample::draw)},
+            {"frameMs", medianOf(&screenSample::frame)},
+            {"steadyLayoutPasses", last.layoutPasses},
+            {"steadyDraws", last.draws},
+            {"steadyCacheRenders", last.cacheRenders}
+        };
+    }
+};
+
+// Everything after building is the same for both screens
+template <typename Build>
+static screenSample measureScreen(Screen& screen, Build build) {
+    screenSample sample;
+
+    auto start = benchClock::now();
+    build();
+    sample.build = msSince(start);
+
+    LayoutStats::beginFrame();
+    start = benchClock::now();
+    screen.update();
+    sample.layout = msSince(start);
+
+    // The first frame renders every cached frame into its texture
+    BeginDrawing();
+    ClearBackground(BLACK);
+    screen.draw();
+    EndDrawing();
+
+    for (int i = 0; i < STEADY_FRAMES; ++i) {
+        LayoutStats::beginFrame();
+        RenderStats::beginFrame();
+
+        start = benchClock::now();
+        screen.update();
+        sample.update += msSince(start);
+
+        auto frameStart = benchClock::now();
+        BeginDrawing();
+        ClearBackground(BLACK);
+        start = benchClock::now();
+        screen.draw();
+        sample.draw += msSince(start);
+        EndDrawing();
+        sample.frame += msSince(frameStart);
+    }
+    sample.update /= STEADY_FRAMES;
+    sample.draw /= STEADY_FRAMES;
+    sample.frame /= STEADY_FRAMES;
+    sample.layoutPasses = LayoutStats::passesThisFrame;
+    sample.draws = RenderStats::drawsThisFrame;
+    sample.cacheRenders = RenderStats::cacheRendersThisFrame;
+    return sample;
+}
+
+static nlohmann::json measureWrap(const Font& font, const WordData& data, int rounds) {
+    std::vector<double> times;
+    size_t lines = 0;
+    for (int r = 0; r < rounds; ++r) {
+        std::vector<TextElement> elements;
+        elements.reserve(data.definitionList.size());
+        for (const auto& definition : data.definitionList) {
+            elements.emplace_back(definition, DEFINITION_FONT_SIZE, WHITE, font);
+            elements.back().useWrapText = true;
+            elements.back().wrapLength = DEFINITION_WIDTH;
+        }
+
+        lines = 0;
+        auto start = benchClock::now();
+        for (auto& element : elements) {
+            element.wrap_text();
+            lines += element.lines.size();
+        }
+        times.push_back(msSince(start));
+    }
+    return {{"definitions", data.definitionList.size()}, {"wrapMs", median(times)}, {"lines", lines}};
+}
+
+static void printScreen(const nlohmann::json& result) {
+    std::cout << "  " << result["screen"].get<std::string>() << " " << result["definitions"].get<size_t>()
+              << "\n    build " << result["buildMs"].get<double>() << " ms, layout " << result["layoutMs"].get<double>()
+              << " ms, update " << result["updateMs"].get<double>() << " ms, draw " << result["drawMs"].get<double>()
+              << " ms, frame " << result["frameMs"].get<double>() << " ms ("
+              << result["steadyDraws"].get<int>() << " draws, " << result["steadyLayoutPasses"].get<int>()
+              << " layout passes)\n";
+}
+
+int main(int argc, char** argv) {
+    std::string jsonPath;
+    std::string fontPath;
+    int rounds = 5;
+    std::vector<size_t> sizes = {10, 100, 1000, 10000};
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg == "--rounds" && i + 1 < argc) rounds = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--font" && i + 1 < argc) fontPath = argv[++i];
+        else if (arg == "--sizes" && i + 1 < argc) {
+            sizes.clear();
+            std::istringstream list(argv[++i]);
+            std::string size;
+            while (std::getline(list, size, ',')) sizes.push_back(std::stoul(size));
+        }
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--json results.json] [--rounds 5] [--font font.ttf] [--sizes 10,100,1000,10000]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    // Full-size hidden window, so layout and texture sizes match the app
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(static_cast<int>(SCREEN_WIDTH), static_cast<int>(SCREEN_HEIGHT), "UiBench");
+
+    nlohmann::json report = {
+        {"bench", "UiBench"},
+        {"width", SCREEN_WIDTH},
+        {"height", SCREEN_HEIGHT},
+        {"rounds", rounds},
+        {"steadyFrames", STEADY_FRAMES},
+        {"font", fontPath.empty() ? "default" : fontPath},
+        {"screens", nlohmann::json::array()},
+        {"wrap", nlohmann::json::array()}
+    };
+
+    {
+        searchScreen search(SCREEN_WIDTH, SCREEN_HEIGHT);
+        screenResult result{"search", 0, {}};
+        for (int r = 0; r < rounds; ++r) {
+            result.rounds.push_back(measureScreen(search, [&]() { search.onEnter(); }));
+            search.onExit();
+        }
+        report["screens"].push_back(result.toJson());
+        printScreen(report["screens"].back());
+    }
+
+    Font wrapFont = fontPath.empty() ? GetFontDefault() : LoadFontEx(fontPath.c_str(), DEFINITION_FONT_SIZE, nullptr, 0);
+
+    for (size_t size : sizes) {
+        WordData data = makeWordData(size);
+
+        dataScreen screen(SCREEN_WIDTH, SCREEN_HEIGHT);
+        screen.onEnter();
+        screenResult result{"data", size, {}};
+        for (int r = 0; r < rounds; ++r) {
+            result.rounds.push_back(measureScreen(screen, [&]() { screen.showWordData(data); }));
+        }
+        screen.onExit();
+        report["screens"].push_back(result.toJson());
+        printScreen(report["screens"].back());
+
+        nlohmann::json wrap = measureWrap(wrapFont, data, rounds);
+        report["wrap"].push_back(wrap);
+        std::cout << "    wrap_text, all definitions " << wrap["wrapMs"].get<double>() << " ms ("
+                  << wrap["lines"].get<size_t>() << " lines)\n";
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        out << report.dump(2) << "\n";
+        if (!out) std::cerr << "Cannot write " << jsonPath << "\n";
+        else std::cout << "wrote " << jsonPath << "\n";
+    }
+
+    if (!fontPath.empty()) UnloadFont(wrapFont);
+    fontManager::instance().unloadAll();
+    CloseWindow();
+    return 0;
+}
@@ -0,0 +1,159 @@
+//
+// Line wrapping cost for long definitions and paragraph-sized example text:
+// the old word-by-word wrap (a new test line per word, re-measured through
+// the TextMeasure cache) against TextElement::wrap_text's single pass.
+//
+// Both sides see a warm advance table, so the difference is the wrapping
+// itself. Line counts are compared first; text without hyphens or soft
+// hyphens has to break in exactly the same places.
+//
+// Usage: WrapBench [font.ttf] [rounds = 20]
+//
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <raylib.h>
+
+#include "textMeasure.h"
+#include "ui.h"
+
+using benchClock = std::chrono::steady_clock;
+
+constexpr int FONT_SIZE = 24;
+constexpr float SPACING = 1.0f;
+
+static const char* WORDS[] = {"the", "of", "a", "to", "move", "swiftly", "quality", "condition", "person",
+                              "especially", "something", "relating", "manner", "used", "which", "state",
+                              "being", "pronounced", "informal", "archaic", "derived", "sense", "figurative",
+                              "characterized", "by", "or", "in", "an", "act", "instance"};
+
+static std::string makeText(std::mt19937& rng, int words) {
+    std::uniform_int_distribution<int> word(0, 29);
+    std::string text;
+    for (int w = 0; w < words; ++w) {
+        if (!text.empty()) text += ' ';
+        text += WORDS[word(rng)];
+    }
+    return text + ".";
+}
+
+struct workload {
+    const char* name;
+    std::vector<std::string> texts;
+    float wrapLength;
+};
+
+static std::vector<workload> makeWorkloads() {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> definitionLength(8, 60);
+
+    workload definitions{"200 definitions", {}, 1400.0f};
+    for (int i = 0; i < 200; ++i) definitions.texts.push_back(makeText(rng, definitionLength(rng)));
+
+    workload narrow{"200 definitions, narrow", definitions.texts, 400.0f};
+
+    workload paragraphs{"20 example paragraphs", {}, 1400.0f};
+    for (int i = 0; i < 20; ++i) paragraphs.texts.push_back(makeText(rng, 400));
+
+    return {definitions, narrow, paragraphs};
+}
+
+// TextElement::wrap_text before the single-pass engine
+static size_t wrapWordByWord(const Font& font, const std::string& text, float wrapLength) {
+    std::istringstream words(text);
+    std::string word;
+    std::string currentLine;
+    std::vector<std::string> lines;
+    float width = 0.0f;
+
+    auto measure = [&](const std::string& line) {
+        return TextMeasure::measure(font, line, static_cast<float>(FONT_SIZE), SPACING).x;
+    };
+
+    while (words >> word) {
+        std::string testLine = currentLine.empty() ? word : currentLine + " " + word;
+        if (measure(testLine) <= wrapLength || currentLine.empty()) {
+            currentLine = testLine;
+        }
+        else {
+            lines.push_back(currentLine);
+            width = std::max(width, measure(currentLine));
+            currentLine = word;
+
+            if (measure(currentLine) > wrapLength) {
+                lines.push_back(currentLine);
+                width = std::max(width, measure(currentLine));
+                currentLine.clear();
+            }
+        }
+    }
+    if (!currentLine.empty()) {
+        lines.push_back(currentLine);
+        width = std::max(width, measure(currentLine));
+    }
+    return lines.size();
+}
+
+static size_t wrapSinglePass(const Font& font, const std::string& text, float wrapLength) {
+    TextElement element(text, FONT_SIZE, WHITE, font);
+    element.useWrapText = true;
+    element.wrapLength = wrapLength;
+    element.wrap_text();
+    return element.lines.size();
+}
+
+template <typename Wrap>
+static double timeLayout(const Font& font, const workload& work, int rounds, Wrap wrap) {
+    size_t lines = 0;
+    auto start = benchClock::now();
+    for (int r = 0; r < rounds; ++r) {
+        // A fresh string cache every round, as when a new word is opened
+        TextMeasure::clear();
+        for (const auto& text : work.texts) lines += wrap(font, text, work.wrapLength);
+    }
+    double seconds = std::chrono::duration<double>(benchClock::now() - start).count();
+    if (lines == 0) std::cerr << "no lines laid out\n";
+    return seconds * 1000.0 / rounds;
+}
+
+int main(int argc, char** argv) {
+    const char* fontPath = argc > 1 ? argv[1] : nullptr;
+    int rounds = argc > 2 ? std::stoi(argv[2]) : 20;
+
+    // Fonts need a GL context
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "WrapBench");
+
+    Font font = fontPath ? LoadFontEx(fontPath, FONT_SIZE, nullptr, 0) : GetFontDefault();
+    std::cout << (fontPath ? fontPath : "default font") << "\n";
+
+    int status = 0;
+    for (const workload& work : makeWorkloads()) {
+        size_t before = 0;
+        size_t after = 0;
+        for (const auto& text : work.texts) {
+            before += wrapWordByWord(font, text, work.wrapLength);
+            after += wrapSinglePass(font, text, work.wrapLength);
+        }
+        if (before != after) {
+            std::cerr << work.name << ": " << before << " lines word by word, " << after << " in one pass\n";
+            status = 1;
+        }
+
+        double wordByWord = timeLayout(font, work, rounds, wrapWordByWord);
+        double singlePass = timeLayout(font, work, rounds, wrapSinglePass);
+
+        std::cout << "  " << work.name << " (" << after << " lines)\n"
+                  << "    word by word   " << wordByWord << " ms per layout\n"
+                  << "    single pass    " << singlePass << " ms (" << wordByWord / singlePass << "x)\n";
+    }
+
+    if (fontPath) UnloadFont(font);
+    CloseWindow();
+    return status;
+}
@@ -0,0 +1,130 @@
+#include "compactWordData.h"
+
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+
+namespace {
+
+struct partOfSpeechTable {
+    std::mutex mutex;
+    std::deque<std::string> names; // deque keeps views into existing names valid
+    std::map<std::string, partOfSpeechId, std::less<>> ids;
+
+    partOfSpeechTable() {
+        // Spelled the way parseWordEntry() stores them
+        for (const char* name : {"_unknown", "_noun", "_verb", "_adjective", "_adverb", "_pronoun", "_preposition",
+                                 "_conjunction", "_interjection", "_determiner", "_article", "_numeral",
+                                 "_particle", "_exclamation", "_abbreviation", "_prefix", "_suffix", "_phrase",
+                                 "_proper noun"}) {
+            add(name);
+        }
+    }
+
+    partOfSpeechId add(std::string_view name) {
+        auto id = static_cast<partOfSpeechId>(names.size());
+        names.emplace_back(name);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+};
+
+partOfSpeechTable& table() {
+    static partOfSpeechTable instance;
+    return instance;
+}
+
+} // namespace
+
+partOfSpeechId internPartOfSpeech(std::string_view name) {
+    auto& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+
+    auto it = t.ids.find(name);
+    if (it != t.ids.end()) return it->second;
+
+    // Real data has a few dozen of these; a table this full means garbage input
+    if (t.names.size() > std::numeric_limits<partOfSpeechId>::max()) return 0;
+
+    return t.add(name);
+}
+
+std::string_view partOfSpeechName(partOfSpeechId id) {
+    auto& t = table();
+    std::lock_guard<std::mutex> lock(t.mutex);
+    return id < t.names.size() ? std::string_view(t.names[id]) : std::string_view(t.names[0]);
+}
+
+compactWordData::compactWordData(const WordData& data) {
+    size_t textBytes = data.word.size() + data.phonetic.size();
+    for (const auto& def : data.definitionList) textBytes += def.size();
+
+    size_t posCount = data.posList.size();
+    size_t defCount = data.definitionList.size();
+    size_t textWords = (textBytes + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    buffer.resize(HEADER_WORDS + posCount + defCount + textWords);
+    buffer[0] = static_cast<uint32_t>(data.word.size());
+    buffer[1] = static_cast<uint32_t>(data.phonetic.size());
+    buffer[2] = static_cast<uint32_t>(posCount);
+    buffer[3] = static_cast<uint32_t>(defCount);
+
+    uint32_t* pos = buffer.data() + HEADER_WORDS;
+    for (size_t i = 0; i < posCount; ++i) pos[i] = internPartOfSpeech(data.posList[i]);
+
+    uint32_t* ends = pos + posCount;
+    char* out = reinterpret_cast<char*>(ends + defCount);
+
+    std::memcpy(out, data.word.data(), data.word.size());
+    out += data.word.size();
+    std::memcpy(out, data.phonetic.data(), data.phonetic.size());
+    out += data.phonetic.size();
+
+    uint32_t end = 0;
+    for (size_t i = 0; i < defCount; ++i) {
+        const std::string& def = data.definitionList[i];
+        std::memcpy(out, def.data(), def.size());
+        out += def.size();
+        end += static_cast<uint32_t>(def.size());
+        ends[i] = end;
+    }
+}
+
+std::string_view compactWordData::word() const {
+    if (empty()) return {};
+    return {text(), buffer[0]};
+}
+
+std::string_view compactWordData::phonetic() const {
+    if (empty()) return {};
+    return {text() + buffer[0], buffer[1]};
+}
+
+partOfSpeechId compactWordData::partOfSpeechAt(size_t i) const {
+    return static_cast<partOfSpeechId>(buffer[HEADER_WORDS + i]);
+}
+
+std::string_view compactWordData::definitionAt(size_t i) const {
+    const uint32_t* ends = defEnds();
+    uint32_t begin = i == 0 ? 0 : ends[i - 1];
+    return {text() + buffer[0] + buffer[1] + begin, ends[i] - begin};
+}
+
+WordData compactWordData::toWordData() const {
+    WordData data;
+    data.word = word();
+    data.phonetic = phonetic();
+
+    data.posList.reserve(partOfSpeechCount());
+    for (size_t i = 0; i < partOfSpeechCount(); ++i) {
+        data.posList.emplace_back(partOfSpeechName(partOfSpeechAt(i)));
+    }
+
+    data.definitionList.reserve(definitionCount());
+    for (size_t i = 0; i < definitionCount(); ++i) {
+        data.definitionList.emplace_back(definitionAt(i));
+    }
+    return data;
+}
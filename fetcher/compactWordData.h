@@ -0,0 +1,61 @@
+#ifndef COMPACT_WORD_DATA_H
+#define COMPACT_WORD_DATA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fetcher.h"
+
+// Small process-wide ID for a part of speech string such as "_noun".
+// The common ones are registered up front; anything else is interned on first use.
+using partOfSpeechId = uint16_t;
+
+partOfSpeechId internPartOfSpeech(std::string_view name);
+std::string_view partOfSpeechName(partOfSpeechId id);
+
+// WordData packed into a single allocation.
+//
+// Layout (uint32 words, then text):
+//   header    wordLength, phoneticLength, posCount, defCount
+//   pos       posCount x partOfSpeechId
+//   defEnds   defCount x end offset of each definition, relative to the first one
+//   text      word, phonetic and every definition back to back, UTF-8, not NUL terminated
+//
+// Copying costs one allocation and moving costs none, whatever the number of
+// definitions. Accessors hand out views into the buffer, valid while the
+// object is alive and unmodified.
+class compactWordData {
+public:
+    compactWordData() = default;
+    explicit compactWordData(const WordData& data);
+
+    [[nodiscard]] bool empty() const { return buffer.empty(); }
+
+    [[nodiscard]] std::string_view word() const;
+    [[nodiscard]] std::string_view phonetic() const;
+
+    [[nodiscard]] size_t partOfSpeechCount() const { return empty() ? 0 : buffer[2]; }
+    [[nodiscard]] partOfSpeechId partOfSpeechAt(size_t i) const;
+
+    [[nodiscard]] size_t definitionCount() const { return empty() ? 0 : buffer[3]; }
+    [[nodiscard]] std::string_view definitionAt(size_t i) const;
+
+    // Expands back into the struct the UI works with
+    [[nodiscard]] WordData toWordData() const;
+
+    // Heap bytes held by this entry
+    [[nodiscard]] size_t bytes() const { return buffer.capacity() * sizeof(uint32_t); }
+
+private:
+    static constexpr size_t HEADER_WORDS = 4;
+
+    std::vector<uint32_t> buffer;
+
+    [[nodiscard]] const uint32_t* defEnds() const { return buffer.data() + HEADER_WORDS + buffer[2]; }
+    [[nodiscard]] const char* text() const { return reinterpret_cast<const char*>(defEnds() + buffer[3]); }
+};
+
+#endif // COMPACT_WORD_DATA_H
@@ -0,0 +1,459 @@
+#include "diskCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t LOG_MAGIC = 0x474C4344;    // "DCLG"
+constexpr uint32_t RECORD_MAGIC = 0x44524352; // "RCRD"
+constexpr uint32_t INDEX_MAGIC = 0x58494344;  // "DCIX"
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint64_t MIN_INDEX_CAPACITY = 64;
+
+struct logHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t generation;
+};
+
+struct recordHeader {
+    uint32_t magic;
+    uint32_t keyLength;
+    uint32_t bodyLength;
+    uint32_t crc;
+};
+
+std::string cacheDirectory = "dictionary_cache";
+uint64_t cacheMaxBytes = diskCache::DEFAULT_MAX_BYTES;
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static const auto table = []() {
+        std::vector<uint32_t> t(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint64_t hashKey(const std::string& key) {
+    uint64_t hash = 1469598103934665603ull; // FNV-1a
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+uint64_t newGeneration() {
+    std::random_device device;
+    uint64_t now = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return (static_cast<uint64_t>(device()) << 32) ^ device() ^ now;
+}
+
+} // namespace
+
+diskCache::~diskCache() {
+    close();
+}
+
+void diskCache::configure(const std::string& dir, uint64_t maxBytes) {
+    cacheDirectory = dir;
+    cacheMaxBytes = maxBytes;
+}
+
+diskCache& diskCache::instance() {
+    static diskCache cache;
+    static std::once_flag opened;
+    std::call_once(opened, []() {
+        if (!cache.open(cacheDirectory, cacheMaxBytes)) {
+            std::cerr << "Disk cache disabled, cannot open " << cacheDirectory << std::endl;
+        }
+    });
+    return cache;
+}
+
+std::string diskCache::logPath() const { return directory + "/responses.log"; }
+std::string diskCache::indexPath() const { return directory + "/responses.idx"; }
+std::string diskCache::lockPath() const { return directory + "/cache.lock"; }
+
+diskCache::indexHeader* diskCache::header() const {
+    return reinterpret_cast<indexHeader*>(indexMap.data());
+}
+
+diskCache::indexSlot* diskCache::slots() const {
+    return reinterpret_cast<indexSlot*>(indexMap.data() + sizeof(indexHeader));
+}
+
+bool diskCache::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return logWriter != nullptr && indexMap.isOpen();
+}
+
+bool diskCache::open(const std::string& dir, uint64_t maxSize) {
+    std::lock_guard<std::mutex> lock(mutex);
+    closeLocked();
+
+    directory = dir;
+    maxBytes = maxSize;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) return false;
+
+    // Before touching the log: two writers would interleave appends and index rebuilds
+    if (!ownerLock.tryLock(lockPath())) {
+        std::cerr << "Disk cache " << directory << " is in use by another process" << std::endl;
+        return false;
+    }
+
+    if (!openLog() || !openIndex()) {
+        closeLocked();
+        return false;
+    }
+    return true;
+}
+
+void diskCache::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closeLocked();
+}
+
+void diskCache::closeLocked() {
+    if (indexMap.data()) {
+        header()->clean = 1;
+        indexMap.flush();
+    }
+    indexMap.close();
+    logMap.close();
+
+    if (logWriter) {
+        std::fclose(logWriter);
+        logWriter = nullptr;
+    }
+
+    // Last, once everything is flushed and the index is marked clean
+    ownerLock.unlock();
+}
+
+bool diskCache::openLog() {
+    std::error_code error;
+    uint64_t size = std::filesystem::exists(logPath(), error) ? std::filesystem::file_size(logPath(), error) : 0;
+
+    logHeader head{};
+    bool valid = false;
+    if (size >= sizeof(logHeader)) {
+        if (std::FILE* file = std::fopen(logPath().c_str(), "rb")) {
+            valid = std::fread(&head, sizeof(head), 1, file) == 1 &&
+                    head.magic == LOG_MAGIC && head.version == FORMAT_VERSION;
+            std::fclose(file);
+        }
+    }
+
+    if (!valid) {
+        std::FILE* file = std::fopen(logPath().c_str(), "wb");
+        if (!file) return false;
+
+        head = logHeader{LOG_MAGIC, FORMAT_VERSION, newGeneration()};
+        bool written = std::fwrite(&head, sizeof(head), 1, file) == 1 && syncFile(file);
+        std::fclose(file);
+        if (!written) return false;
+    }
+
+    generation = head.generation;
+    logWriter = std::fopen(logPath().c_str(), "ab");
+    return logWriter != nullptr && logMap.open(logPath(), false);
+}
+
+bool diskCache::openIndex() {
+    if (!indexMap.open(indexPath(), true)) return false;
+
+    const indexHeader* head = indexMap.size() >= sizeof(indexHeader) ? header() : nullptr;
+    bool valid = head &&
+                 head->magic == INDEX_MAGIC &&
+                 head->version == FORMAT_VERSION &&
+                 head->generation == generation &&
+                 head->clean == 1 &&
+                 head->capacity >= MIN_INDEX_CAPACITY &&
+                 indexMap.size() == sizeof(indexHeader) + head->capacity * sizeof(indexSlot) &&
+                 head->logBytes == logMap.size();
+
+    if (!valid) {
+        uint64_t capacity = head && head->magic == INDEX_MAGIC ? std::max(head->capacity, MIN_INDEX_CAPACITY)
+                                                               : MIN_INDEX_CAPACITY;
+        if (!rebuildIndex(capacity)) return false;
+    }
+
+    // Stays dirty until closeLocked(), so a crash forces a rebuild on the next start
+    header()->clean = 0;
+    indexMap.flush();
+    return true;
+}
+
+bool diskCache::createIndex(uint64_t capacity) {
+    if (!indexMap.resize(sizeof(indexHeader) + capacity * sizeof(indexSlot))) return false;
+
+    std::memset(indexMap.data(), 0, indexMap.size());
+    *header() = indexHeader{INDEX_MAGIC, FORMAT_VERSION, generation, capacity, 0, sizeof(logHeader), 0, 0};
+    return true;
+}
+
+bool diskCache::rebuildIndex(uint64_t capacity) {
+    if (!createIndex(capacity)) return false;
+
+    const uint8_t* log = logMap.data();
+    uint64_t logSize = logMap.size();
+    uint64_t offset = sizeof(logHeader);
+
+    while (offset + sizeof(recordHeader) <= logSize) {
+        recordHeader record;
+        std::memcpy(&record, log + offset, sizeof(record));
+
+        uint64_t length = sizeof(recordHeader) + uint64_t{record.keyLength} + record.bodyLength;
+        if (record.magic != RECORD_MAGIC || offset + length > logSize) break;
+
+        const uint8_t* payload = log + offset + sizeof(recordHeader);
+        if (crc32(payload, length - sizeof(recordHeader)) != record.crc) break;
+
+        std::string key(reinterpret_cast<const char*>(payload), record.keyLength);
+        header()->logBytes = offset + length;
+        if (!insertSlot(hashKey(key), offset, length, key)) return false;
+
+        offset += length;
+    }
+
+    if (offset < logSize) {
+        // Torn or corrupt tail from an interrupted append
+        std::cerr << "Disk cache: dropping " << (logSize - offset) << " bytes of damaged log tail" << std::endl;
+
+        logMap.close();
+        std::fclose(logWriter);
+        logWriter = nullptr;
+
+        std::error_code error;
+        std::filesystem::resize_file(logPath(), offset, error);
+        if (error) return false;
+
+        logWriter = std::fopen(logPath().c_str(), "ab");
+        if (!logWriter || !logMap.open(logPath(), false)) return false;
+    }
+
+    header()->logBytes = offset;
+    return true;
+}
+
+bool diskCache::growIndex() {
+    uint64_t capacity = header()->capacity;
+    uint64_t count = header()->count;
+    uint64_t logBytes = header()->logBytes;
+    uint64_t liveBytes = header()->liveBytes;
+
+    std::vector<indexSlot> occupied;
+    occupied.reserve(count);
+    for (uint64_t i = 0; i < capacity; ++i) {
+        if (slots()[i].hash != 0) occupied.push_back(slots()[i]);
+    }
+
+    if (!createIndex(capacity * 2)) return false;
+
+    uint64_t mask = header()->capacity - 1;
+    for (const auto& slot : occupied) {
+        uint64_t i = slot.hash & mask;
+        while (slots()[i].hash != 0) i = (i + 1) & mask;
+        slots()[i] = slot;
+    }
+
+    header()->count = count;
+    header()->logBytes = logBytes;
+    header()->liveBytes = liveBytes;
+    return true;
+}
+
+bool diskCache::insertSlot(uint64_t hash, uint64_t offset, uint64_t length, const std::string& key) {
+    if ((header()->count + 1) * 10 > header()->capacity * 7 && !growIndex()) return false;
+
+    uint64_t mask = header()->capacity - 1;
+    uint64_t i = hash & mask;
+
+    while (slots()[i].hash != 0) {
+        indexSlot& slot = slots()[i];
+        std::string existing;
+        if (slot.hash == hash && readRecord(slot.offset, slot.length, &existing, nullptr) && existing == key) {
+            // Newer record supersedes the old one, which becomes dead space until compaction
+            header()->liveBytes = header()->liveBytes - slot.length + length;
+            slot.offset = offset;
+            slot.length = length;
+            return true;
+        }
+        i = (i + 1) & mask;
+    }
+
+    slots()[i] = indexSlot{hash, offset, length};
+    header()->count++;
+    header()->liveBytes += length;
+    return true;
+}
+
+bool diskCache::readRecord(uint64_t offset, uint64_t length, std::string* key, std::string* body) {
+    if (offset + length > logMap.size()) {
+        // Appended after the log was mapped
+        if (!logMap.open(logPath(), false) || offset + length > logMap.size()) return false;
+    }
+
+    recordHeader record;
+    std::memcpy(&record, logMap.data() + offset, sizeof(record));
+    if (record.magic != RECORD_MAGIC) return false;
+
+    const char* payload = reinterpret_cast<const char*>(logMap.data() + offset + sizeof(recordHeader));
+    if (key) key->assign(payload, record.keyLength);
+    if (body) body->assign(payload + record.keyLength, record.bodyLength);
+    return true;
+}
+
+std::optional<std::string> diskCache::get(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!indexMap.data()) return std::nullopt;
+
+    uint64_t hash = hashKey(key);
+    uint64_t mask = header()->capacity - 1;
+
+    for (uint64_t i = hash & mask; slots()[i].hash != 0; i = (i + 1) & mask) {
+        const indexSlot& slot = slots()[i];
+        if (slot.hash != hash) continue;
+
+        std::string storedKey;
+        std::string body;
+        if (readRecord(slot.offset, slot.length, &storedKey, &body) && storedKey == key) {
+            counters.hits++;
+            return body;
+        }
+    }
+
+    counters.misses++;
+    return std::nullopt;
+}
+
+bool diskCache::put(const std::string& key, const std::string& body) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!logWriter || !indexMap.data()) return false;
+
+    uint64_t length = sizeof(recordHeader) + key.size() + body.size();
+    if (length > maxBytes) return false;
+
+    recordHeader record{RECORD_MAGIC, static_cast<uint32_t>(key.size()), static_cast<uint32_t>(body.size()), 0};
+    record.crc = crc32(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+    record.crc = crc32(reinterpret_cast<const uint8_t*>(body.data()), body.size(), record.crc);
+
+    uint64_t offset = header()->logBytes;
+
+    // The record must be durable before the index points at it
+    bool written = std::fwrite(&record, sizeof(record), 1, logWriter) == 1 &&
+                   std::fwrite(key.data(), 1, key.size(), logWriter) == key.size() &&
+                   std::fwrite(body.data(), 1, body.size(), logWriter) == body.size() &&
+                   syncFile(logWriter);
+    if (!written) {
+        // The tail may now hold a partial record, let a rebuild sort it out
+        std::cerr << "Disk cache: append failed, rebuilding index" << std::endl;
+        logMap.open(logPath(), false);
+        rebuildIndex(header()->capacity);
+        return false;
+    }
+
+    header()->logBytes = offset + length;
+    if (!insertSlot(hashKey(key), offset, length, key)) return false;
+    counters.appends++;
+
+    if (header()->logBytes > maxBytes) {
+        compactLocked(maxBytes / 4 * 3);
+    }
+    return true;
+}
+
+bool diskCache::compact(uint64_t targetBytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return compactLocked(targetBytes);
+}
+
+bool diskCache::compactLocked(uint64_t targetBytes) {
+    if (!indexMap.data()) return false;
+
+    if (!logMap.open(logPath(), false)) return false;
+
+    std::vector<indexSlot> live;
+    live.reserve(header()->count);
+    for (uint64_t i = 0; i < header()->capacity; ++i) {
+        if (slots()[i].hash != 0) live.push_back(slots()[i]);
+    }
+
+    // Oldest records first, those are the ones dropped to meet the target
+    std::sort(live.begin(), live.end(),
+        [](const indexSlot& a, const indexSlot& b) { return a.offset < b.offset; });
+
+    uint64_t liveBytes = header()->liveBytes;
+    size_t first = 0;
+    while (first < live.size() && sizeof(logHeader) + liveBytes > targetBytes) {
+        liveBytes -= live[first].length;
+        first++;
+    }
+
+    std::string tempPath = logPath() + ".tmp";
+    std::FILE* temp = std::fopen(tempPath.c_str(), "wb");
+    if (!temp) return false;
+
+    logHeader head{LOG_MAGIC, FORMAT_VERSION, newGeneration()};
+    bool written = std::fwrite(&head, sizeof(head), 1, temp) == 1;
+    for (size_t i = first; written && i < live.size(); ++i) {
+        written = std::fwrite(logMap.data() + live[i].offset, 1, live[i].length, temp) == live[i].length;
+    }
+    written = written && syncFile(temp);
+    std::fclose(temp);
+
+    if (!written) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    uint64_t capacity = header()->capacity;
+
+    // The new log has a new generation, so a crash after the rename only costs an index rebuild
+    logMap.close();
+    std::fclose(logWriter);
+    logWriter = nullptr;
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, logPath(), error);
+    if (error) {
+        std::remove(tempPath.c_str());
+    }
+
+    if (!openLog() || !rebuildIndex(capacity)) {
+        closeLocked();
+        return false;
+    }
+
+    counters.compactions++;
+    return !error;
+}
+
+diskCacheStats diskCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    diskCacheStats result = counters;
+    if (indexMap.data()) {
+        result.entries = header()->count;
+        result.logBytes = header()->logBytes;
+        result.liveBytes = header()->liveBytes;
+    }
+    return result;
+}
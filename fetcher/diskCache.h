@@ -0,0 +1,108 @@
+#ifndef DISK_CACHE_H
+#define DISK_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "mappedFile.h"
+
+struct diskCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t appends{0};
+    uint64_t compactions{0};
+    uint64_t entries{0};
+    uint64_t logBytes{0};
+    uint64_t liveBytes{0};
+};
+
+// Persistent cache of raw API responses, keyed by normalizeWord(query).
+//
+// responses.log is an append-only file of CRC-checked records and is the
+// source of truth. responses.idx is an open-addressing hash table over it,
+// memory-mapped at startup so a warm lookup is a probe plus one record read.
+// The index is only trusted after a clean shutdown; otherwise it is rebuilt
+// by scanning the log, and a torn record at the tail is cut off.
+// One process at a time owns a cache directory, through an exclusive lock on
+// its cache.lock; open() fails while another process holds it.
+class diskCache {
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 64ull * 1024 * 1024;
+
+    diskCache() = default;
+    ~diskCache();
+
+    diskCache(const diskCache&) = delete;
+    diskCache& operator=(const diskCache&) = delete;
+
+    bool open(const std::string& directory, uint64_t maxBytes = DEFAULT_MAX_BYTES);
+    void close();
+    [[nodiscard]] bool isOpen() const;
+
+    std::optional<std::string> get(const std::string& key);
+    bool put(const std::string& key, const std::string& body);
+
+    // Rewrites the log with only the newest record per key, dropping the
+    // oldest records until live data fits in targetBytes.
+    bool compact(uint64_t targetBytes);
+
+    [[nodiscard]] diskCacheStats stats() const;
+
+    // Where instance() opens its files. Only has an effect before the first instance() call.
+    static void configure(const std::string& directory, uint64_t maxBytes = DEFAULT_MAX_BYTES);
+
+    // Cache sitting under fetchWordData
+    static diskCache& instance();
+
+private:
+    struct indexHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t generation;
+        uint64_t capacity;
+        uint64_t count;
+        uint64_t logBytes;
+        uint64_t liveBytes;
+        uint64_t clean;
+    };
+
+    struct indexSlot {
+        uint64_t hash;   // 0 marks an empty slot
+        uint64_t offset; // record offset in the log
+        uint64_t length; // record length including its header
+    };
+
+    std::string directory;
+    uint64_t maxBytes{DEFAULT_MAX_BYTES};
+    uint64_t generation{0};
+
+    std::FILE* logWriter{nullptr};
+    mappedFile logMap;
+    mappedFile indexMap;
+    fileLock ownerLock;
+
+    mutable std::mutex mutex;
+    diskCacheStats counters;
+
+    [[nodiscard]] std::string logPath() const;
+    [[nodiscard]] std::string indexPath() const;
+    [[nodiscard]] std::string lockPath() const;
+
+    indexHeader* header() const;
+    indexSlot* slots() const;
+
+    bool openLog();
+    bool openIndex();
+    bool rebuildIndex(uint64_t capacity);
+    bool createIndex(uint64_t capacity);
+    bool insertSlot(uint64_t hash, uint64_t offset, uint64_t length, const std::string& key);
+    bool growIndex();
+    bool readRecord(uint64_t offset, uint64_t length, std::string* key, std::string* body);
+    bool compactLocked(uint64_t targetBytes);
+    void closeLocked();
+};
+
+#endif // DISK_CACHE_H
@@ -1,81 +1,251 @@
 #include "fetcher.h" // Assuming the header is in the same directory
+#include "wordCache.h"
+#include "diskCache.h"
+#include "lexicon.h"
+#include "hedgedClient.h"
+#include "saxExtractor.h"
+#include "singleFlight.h"
+#include "profiler.h"
 
-WordData fetchWordData(const std::string &wordToSearch) {
-    WordData data;
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <memory>
+#include <mutex>
 
-    // Set default values for error cases
-    data.word = "Not Found";
-    data.phonetic = "/not_found/";
+static std::atomic<parserBackend> activeParser{parserBackend::Sax};
 
-    std::string url = "https://api.dictionaryapi.dev/api/v2/entries/en/" + wordToSearch;
-    cpr::Response r = cpr::Get(cpr::Url{url});
+// Lookups of the same word that overlap share one trip through the slower tiers
+static singleFlight<WordData>& lookupFlights() {
+    static singleFlight<WordData> flights;
+    return flights;
+}
 
-    if (r.status_code != 200) {
-        std::cerr << "Error fetching data: " << r.status_code << std::endl;
-        data.definitionList.push_back("Failed to fetch data from the API.");
-        return data;
+singleFlightStats coalescingStats() {
+    return lookupFlights().stats();
+}
+
+using fetchOverride = std::function<WordData(const std::string &)>;
+
+static std::mutex overrideMutex;
+static std::shared_ptr<const fetchOverride> activeOverride;
+
+void setFetchOverride(fetchOverride lookup) {
+    std::lock_guard<std::mutex> lock(overrideMutex);
+    activeOverride = lookup ? std::make_shared<const fetchOverride>(std::move(lookup)) : nullptr;
+}
+
+static std::shared_ptr<const fetchOverride> currentOverride() {
+    std::lock_guard<std::mutex> lock(overrideMutex);
+    return activeOverride;
+}
+
+static std::mutex baseUrlMutex;
+static std::string baseUrl = DEFAULT_API_BASE_URL;
+
+void setApiBaseUrl(const std::string &url) {
+    std::lock_guard<std::mutex> lock(baseUrlMutex);
+    baseUrl = url;
+}
+
+std::string apiBaseUrl() {
+    std::lock_guard<std::mutex> lock(baseUrlMutex);
+    return baseUrl;
+}
+
+void setParserBackend(parserBackend backend) {
+    activeParser.store(backend, std::memory_order_relaxed);
+}
+
+parserBackend getParserBackend() {
+    return activeParser.load(std::memory_order_relaxed);
+}
+
+std::string normalizeWord(const std::string &word) {
+    size_t begin = 0;
+    size_t end = word.size();
+
+    while (begin < end && std::isspace(static_cast<unsigned char>(word[begin]))) begin++;
+    while (end > begin && std::isspace(static_cast<unsigned char>(word[end - 1]))) end--;
+
+    std::string key = word.substr(begin, end - begin);
+    for (char &c : key) {
+        // ASCII case folding only, UTF-8 continuation bytes pass through untouched
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return key;
+}
+
+void parseWordEntry(const nlohmann::json &entry, WordData &data) {
+    // fetching word
+    if (entry.contains("word") && entry["word"].is_string()) {
+        data.word = entry["word"].get<std::string>();
     }
 
-    try {
-        // FIX 1: Corrected library name 'nlohmann'
-        // FIX 2: Consistent variable name 'jsonData'
-        auto jsonData = nlohmann::json::parse(r.text);
+    // fetching phonetics
+    if (entry.contains("phonetic") && entry["phonetic"].is_string()) {
+        data.phonetic = entry["phonetic"].get<std::string>();
+    } else if (entry.contains("phonetics") && !entry["phonetics"].empty()) {
+        for (const auto &phonetic_obj : entry["phonetics"]) {
+            if (phonetic_obj.contains("text") && phonetic_obj["text"].is_string()) {
+                data.phonetic = phonetic_obj["text"].get<std::string>();
+                if (!data.phonetic.empty()) break;
+            }
+        }
+    }
 
-        if (!jsonData.empty() && jsonData.is_array()) {
-            auto entry = jsonData[0];
+    if (data.phonetic.empty())
+        data.phonetic = "-";
 
-            // fetching word
-            if (entry.contains("word") && entry["word"].is_string()) {
-                data.word = entry["word"].get<std::string>();
+    // fetching parts of speech and definitions
+    if (entry.contains("meanings") && entry["meanings"].is_array()) {
+        // Sorted and deduplicated once at the end instead of node by node in a std::set
+        std::vector<std::string> uniquePos;
+
+        for (const auto &meaning : entry["meanings"]) {
+            if (meaning.contains("partOfSpeech") && meaning["partOfSpeech"].is_string()) {
+                // FIX 3: Declared the 'pos' variable
+                std::string pos = "_" + meaning["partOfSpeech"].get<std::string>();
+                uniquePos.push_back(std::move(pos));
             }
 
-            // fetching phonetics
-            if (entry.contains("phonetic") && entry["phonetic"].is_string()) {
-                data.phonetic = entry["phonetic"].get<std::string>();
-            } else if (entry.contains("phonetics") && !entry["phonetics"].empty()) {
-                for (const auto &phonetic_obj : entry["phonetics"]) {
-                    if (phonetic_obj.contains("text") && phonetic_obj["text"].is_string()) {
-                        data.phonetic = phonetic_obj["text"].get<std::string>();
-                        if (!data.phonetic.empty()) break;
+            if (meaning.contains("definitions") && meaning["definitions"].is_array()) {
+                for (const auto &defObject : meaning["definitions"]) {
+                    if (defObject.contains("definition") && defObject["definition"].is_string()) {
+                        std::string definitionText = defObject["definition"].get<std::string>();
+                        data.definitionList.push_back(definitionText);
                     }
                 }
             }
+        }
+        
+        // FIX 4 (Logical Error): Moved this line outside the loop
+        std::sort(uniquePos.begin(), uniquePos.end());
+        uniquePos.erase(std::unique(uniquePos.begin(), uniquePos.end()), uniquePos.end());
+        data.posList = std::move(uniquePos);
+    }
+}
 
-            if (data.phonetic.empty())
-                data.phonetic = "-";
+bool parseWordDataDom(const std::string &body, WordData &data) {
+    data = WordData{};
 
-            // fetching parts of speech and definitions
-            if (entry.contains("meanings") && entry["meanings"].is_array()) {
-                std::set<std::string> uniquePosSet;
+    // Set default values for error cases
+    data.word = "Not Found";
+    data.phonetic = "/not_found/";
 
-                for (const auto &meaning : entry["meanings"]) {
-                    if (meaning.contains("partOfSpeech") && meaning["partOfSpeech"].is_string()) {
-                        // FIX 3: Declared the 'pos' variable
-                        std::string pos = "_" + meaning["partOfSpeech"].get<std::string>();
-                        uniquePosSet.insert(pos);
-                    }
+    try {
+        // FIX 1: Corrected library name 'nlohmann'
+        // FIX 2: Consistent variable name 'jsonData'
+        auto jsonData = nlohmann::json::parse(body);
 
-                    if (meaning.contains("definitions") && meaning["definitions"].is_array()) {
-                        for (const auto &defObject : meaning["definitions"]) {
-                            if (defObject.contains("definition") && defObject["definition"].is_string()) {
-                                std::string definitionText = defObject["definition"].get<std::string>();
-                                data.definitionList.push_back(definitionText);
-                            }
-                        }
-                    }
-                }
-                
-                // FIX 4 (Logical Error): Moved this line outside the loop
-                data.posList = std::vector<std::string>(uniquePosSet.begin(), uniquePosSet.end());
-            }
+        // Valid JSON without an entry, e.g. [] or an error object, is no answer to keep
+        if (!jsonData.is_array() || jsonData.empty() || !jsonData[0].is_object()) {
+            return false;
         }
+        parseWordEntry(jsonData[0], data);
     }
     // FIX 5: Added a specific 'catch' block for JSON errors
     catch (const nlohmann::json::parse_error& e) {
         std::cerr << "JSON parse error: " << e.what() << std::endl;
         data.definitionList.push_back("Failed to parse the response from the API.");
+        return false;
     }
 
     // FIX 6: Added the final 'return' statement for the success path
+    return true;
+}
+
+bool parseWordData(const std::string &body, WordData &data) {
+    PROFILE_SCOPE("parseWordData");
+    if (getParserBackend() == parserBackend::Dom) {
+        return parseWordDataDom(body, data);
+    }
+    return parseWordDataSax(body, data);
+}
+
+// Returns false when the result is an error placeholder that must not be cached.
+static bool fetchFromNetwork(const std::string &wordToSearch, WordData &data,
+                             const std::shared_ptr<const std::atomic<bool>> &cancel) {
+    PROFILE_SCOPE("fetchFromNetwork");
+    std::string url = apiBaseUrl() + wordToSearch;
+    httpResult r = hedgedClient::instance().get(url, cancel);
+
+    if (r.cancelled) {
+        data = WordData{};
+        data.word = "Not Found";
+        data.phonetic = "/not_found/";
+        data.definitionList.push_back("The lookup was cancelled.");
+        data.cancelled = true;
+        return false;
+    }
+
+    if (r.statusCode == 404) {
+        data = WordData{};
+        data.word = "Not Found";
+        data.phonetic = "/not_found/";
+        data.definitionList.push_back("\"" + wordToSearch + "\" is not in the dictionary.");
+        data.missingWord = true;
+        return false;
+    }
+
+    if (r.statusCode != 200) {
+        std::cerr << "Error fetching data: " << r.statusCode;
+        if (!r.error.empty()) std::cerr << " (" << r.error << ")";
+        std::cerr << std::endl;
+        data = WordData{};
+        data.word = "Not Found";
+        data.phonetic = "/not_found/";
+        data.definitionList.push_back("Failed to fetch data from the API.");
+        return false;
+    }
+
+    if (!parseWordData(r.body, data)) {
+        return false;
+    }
+
+    diskCache::instance().put(wordToSearch, r.body);
+    return true;
+}
+
+// Everything below the memory cache, for a key that is already normalized
+static WordData fetchUncached(const std::string &key, const std::shared_ptr<const std::atomic<bool>> &cancel) {
+    // Offline lexicon, when one has been imported
+    if (auto offline = lexicon::instance().find(key)) {
+        wordCache::instance().put(key, *offline);
+        return *offline;
+    }
+
+    WordData data;
+
+    // Warm after a restart: the raw response is still on disk
+    if (auto body = diskCache::instance().get(key)) {
+        if (parseWordData(*body, data)) {
+            wordCache::instance().put(key, data);
+            return data;
+        }
+    }
+
+    if (fetchFromNetwork(key, data, cancel)) {
+        wordCache::instance().put(key, data);
+    }
     return data;
 }
+
+WordData fetchWordData(const std::string &wordToSearch, std::shared_ptr<const std::atomic<bool>> cancel) {
+    PROFILE_SCOPE("fetchWordData");
+    std::string key = normalizeWord(wordToSearch);
+
+    if (auto lookup = currentOverride()) {
+        return (*lookup)(key);
+    }
+
+    if (auto cached = wordCache::instance().get(key)) {
+        return *cached;
+    }
+
+    while (true) {
+        WordData data = lookupFlights().run(key, [&key, &cancel]() { return fetchUncached(key, cancel); });
+        if (!data.cancelled || (cancel && cancel->load(std::memory_order_relaxed))) return data;
+        // Joined a lookup that its own caller gave up on; this one still wants the word
+    }
+}
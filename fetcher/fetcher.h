@@ -23,19 +23,76 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "singleFlight.h"
+
 // A struct to hold all the parsed data for a word.
 struct WordData {
     std::string word;
     std::string phonetic;
     std::vector<std::string> posList;
     std::vector<std::string> definitionList;
+
+    // Only on a "Not Found" placeholder: the API answered that the word does
+    // not exist (404), as opposed to a lookup that failed
+    bool missingWord = false;
+
+    // Only on the placeholder of a lookup whose caller gave up on it
+    bool cancelled = false;
 };
 
 // Function DECLARATION (prototype).
 // The implementation is now in fetcher.cpp.
-WordData fetchWordData(const std::string &wordToSearch);
+// Lookups go through wordCache::instance(), then the offline lexicon::instance(),
+// then diskCache::instance(), then the network through hedgedClient::instance().
+// Concurrent calls for the same word that miss the memory cache wait for the
+// first one instead of repeating it.
+//
+// Setting cancel aborts the network request; the call then returns a
+// placeholder marked cancelled, which is never cached. A call that joined
+// someone else's lookup is not affected when that one is cancelled.
+WordData fetchWordData(const std::string &wordToSearch, std::shared_ptr<const std::atomic<bool>> cancel = {});
+
+// How many fetchWordData calls were folded into one already in flight
+singleFlightStats coalescingStats();
+
+// Answers every fetchWordData call from lookup instead of the caches and the
+// network, e.g. with canned data for a deterministic input replay. An empty
+// function goes back to normal lookups.
+void setFetchOverride(std::function<WordData(const std::string &normalizedWord)> lookup);
+
+// Where network lookups go; the normalized word is appended as is. Defaults to
+// DEFAULT_API_BASE_URL. Point it at a local stand-in such as
+// MockDictionaryServer to test or load-test without the public API.
+inline constexpr const char *DEFAULT_API_BASE_URL = "https://api.dictionaryapi.dev/api/v2/entries/en/";
+
+void setApiBaseUrl(const std::string &url);
+std::string apiBaseUrl();
+
+// Parses one API response body. Returns false (and fills in the "Not Found"
+// placeholder) when the body is not valid JSON or holds no entry object, e.g.
+// a 200 with [], so the placeholder is never cached.
+bool parseWordData(const std::string &body, WordData &data);
+
+// Which parser parseWordData() uses. Both fill WordData identically; Sax
+// skips building the DOM and is the default.
+enum class parserBackend { Dom, Sax };
+
+void setParserBackend(parserBackend backend);
+parserBackend getParserBackend();
+
+// The DOM backend on its own, kept as the reference implementation.
+bool parseWordDataDom(const std::string &body, WordData &data);
+
+// Fills word, phonetic, posList and definitionList from one entry object of a response.
+void parseWordEntry(const nlohmann::json &entry, WordData &data);
+
+// Trimmed, ASCII case-folded form of a query. Used as the key by every cache layer.
+std::string normalizeWord(const std::string &word);
 
 #endif
@@ -0,0 +1,351 @@
+#include "hedgedClient.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+using requestClock = std::chrono::steady_clock;
+
+namespace {
+
+double msSince(requestClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(requestClock::now() - start).count();
+}
+
+} // namespace
+
+struct hedgedClient::race {
+    std::mutex mutex;
+    std::condition_variable decided;
+    std::atomic<bool> cancel{false}; // set once there is a winner, aborts the other copy
+    std::shared_ptr<const std::atomic<bool>> callerCancel; // aborts every copy; kept alive for the losers
+    std::optional<httpResult> winner;
+    bool hedgeWon = false;
+    int pending = 0;
+    std::array<httpSession*, 2> sessions{}; // first copy, hedge; set while that copy's get() runs
+    requestClock::time_point start = requestClock::now();
+
+    // Caller holds mutex. A session is only set while its owner is inside get(), so it is alive.
+    void interruptAll() {
+        for (httpSession* session : sessions) {
+            if (session != nullptr) session->interrupt();
+        }
+    }
+};
+
+// Requests waiting on a hedge or a cancel, and the threads that act on them.
+// Every thread waits for the earliest hedge deadline, or for CANCEL_POLL while
+// a watched request has a caller's flag; the one that wakes for a due hedge
+// sends it from its own session. Started on first use, never destroyed, and
+// joined by hedgedClient::shutdown().
+class hedgedClient::hedgePool {
+public:
+    static hedgePool& instance() {
+        static hedgePool* pool = new hedgePool();
+        return *pool;
+    }
+
+    // False once the pool has stopped. Pass time_point::max() to only watch for a cancel.
+    bool watch(hedgedClient* client, const std::shared_ptr<race>& shared, const std::string& url,
+               requestClock::time_point hedgeAt) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) return false;
+        if (threads.empty()) {
+            for (size_t i = 0; i < HEDGE_THREADS; i++) threads.emplace_back([this]() { run(); });
+        }
+        watches.push_back({client, shared, url, hedgeAt});
+        wake.notify_one();
+        return true;
+    }
+
+    void forget(const std::shared_ptr<race>& shared) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::erase_if(watches, [&shared](const entry& e) { return e.shared == shared; });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) return;
+            stopping = true;
+            watches.clear();
+            for (const auto& shared : sending) {
+                // Whoever is still waiting on these gets a cancelled result
+                std::lock_guard<std::mutex> raceLock(shared->mutex);
+                shared->cancel.store(true, std::memory_order_relaxed);
+                shared->interruptAll();
+            }
+        }
+        wake.notify_all();
+        for (auto& thread : threads) thread.join();
+        threads.clear();
+    }
+
+private:
+    struct entry {
+        hedgedClient* client;
+        std::shared_ptr<race> shared;
+        std::string url;
+        requestClock::time_point hedgeAt;
+    };
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<entry> watches;
+    std::vector<std::shared_ptr<race>> sending;
+    std::vector<std::thread> threads;
+    bool stopping = false;
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            auto now = requestClock::now();
+            auto next = requestClock::time_point::max();
+            std::optional<entry> due;
+
+            for (auto it = watches.begin(); it != watches.end();) {
+                if (isSet(it->shared->callerCancel)) {
+                    std::lock_guard<std::mutex> raceLock(it->shared->mutex);
+                    it->shared->interruptAll();
+                    it = watches.erase(it);
+                    continue;
+                }
+                if (!due && it->hedgeAt <= now) {
+                    due = std::move(*it);
+                    it = watches.erase(it);
+                    continue;
+                }
+                next = std::min(next, it->hedgeAt);
+                if (it->shared->callerCancel) next = std::min(next, now + CANCEL_POLL);
+                ++it;
+            }
+
+            if (!due) {
+                wake.wait_until(lock, next);
+                continue;
+            }
+
+            sending.push_back(due->shared);
+            lock.unlock();
+            due->client->sendHedge(due->shared, due->url);
+            lock.lock();
+            std::erase(sending, due->shared);
+        }
+    }
+};
+
+hedgedClient& hedgedClient::instance() {
+    // Never destroyed: the hedge pool may hold on to it until shutdown()
+    static hedgedClient* client = new hedgedClient();
+    return *client;
+}
+
+void hedgedClient::shutdown() {
+    hedgePool::instance().stop();
+}
+
+bool hedgedClient::retryable(const httpResult& result) {
+    // No response at all, timeouts included. A cancelled copy lost a race, it did not fail.
+    if (result.statusCode == 0) return !result.cancelled;
+    // The server or a proxy asking to come back later; anything else is the answer
+    return result.statusCode == 429 || result.statusCode == 502 || result.statusCode == 503 ||
+           result.statusCode == 504;
+}
+
+bool hedgedClient::isSet(const std::shared_ptr<const std::atomic<bool>>& cancel) {
+    return cancel && cancel->load(std::memory_order_relaxed);
+}
+
+httpResult hedgedClient::get(const std::string& url, std::shared_ptr<const std::atomic<bool>> cancel) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.requests++;
+        hedgeTokens = std::min(HEDGE_BURST, hedgeTokens + HEDGE_BUDGET);
+    }
+
+    httpResult cancelled;
+    cancelled.error = "Cancelled by the caller";
+    cancelled.cancelled = true;
+
+    for (int attempt = 1;; ++attempt) {
+        if (isSet(cancel)) return cancelled;
+
+        httpResult result = getOnce(url, cancel);
+        // An answer that made it back is still worth handing over, e.g. to cache
+        if (isSet(cancel)) return result.statusCode != 0 ? result : cancelled;
+        if (attempt >= MAX_ATTEMPTS || !retryable(result)) return result;
+
+        // Full jitter: anywhere up to the capped exponential step, so clients
+        // that failed together do not come back together
+        auto ceiling = std::min(BACKOFF_CAP, BACKOFF_BASE * (1 << (attempt - 1)));
+        thread_local std::mt19937 rng(std::random_device{}());
+        std::uniform_int_distribution<long long> wait(0, ceiling.count());
+        auto retryAt = requestClock::now() + std::chrono::milliseconds(wait(rng));
+        // Slept in CANCEL_POLL slices, like the waits in getOnce()
+        for (auto left = retryAt - requestClock::now(); left > requestClock::duration::zero();
+             left = retryAt - requestClock::now()) {
+            if (isSet(cancel)) return cancelled;
+            std::this_thread::sleep_for(cancel ? std::min<requestClock::duration>(left, CANCEL_POLL) : left);
+        }
+        if (isSet(cancel)) return cancelled;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.retries++;
+    }
+}
+
+httpResult hedgedClient::getOnce(const std::string& url, const std::shared_ptr<const std::atomic<bool>>& cancel) {
+    auto shared = std::make_shared<race>();
+    shared->callerCancel = cancel;
+
+    bool hedge = hedging.load(std::memory_order_relaxed);
+    bool watched = false;
+    if (hedge || cancel) {
+        auto hedgeAt = hedge ? shared->start + hedgeAfter() : requestClock::time_point::max();
+        watched = hedgePool::instance().watch(this, shared, url, hedgeAt);
+    }
+
+    attempt(shared, url, false);
+    if (watched) hedgePool::instance().forget(shared);
+
+    // A first copy that failed still waits for a hedge that is out
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    auto settled = [&shared, &cancel]() { return shared->winner.has_value() || isSet(cancel); };
+    if (cancel) {
+        // Nothing signals the caller's flag, so it is checked every CANCEL_POLL
+        while (!shared->decided.wait_for(lock, CANCEL_POLL, settled)) {}
+    }
+    else {
+        shared->decided.wait(lock, settled);
+    }
+
+    if (!shared->winner) {
+        // Given up by the caller; the hedge still out is cut off
+        shared->cancel.store(true, std::memory_order_relaxed);
+        shared->interruptAll();
+        httpResult cancelled;
+        cancelled.error = "Cancelled by the caller";
+        cancelled.cancelled = true;
+        return cancelled;
+    }
+    return std::move(*shared->winner);
+}
+
+void hedgedClient::sendHedge(const std::shared_ptr<race>& shared, const std::string& url) {
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        if (shared->winner || isSet(shared->callerCancel)) return;
+    }
+    if (takeHedgeToken()) attempt(shared, url, true);
+}
+
+void hedgedClient::attempt(const std::shared_ptr<race>& shared, const std::string& url, bool hedge) {
+    httpSession& session = httpSession::forThisThread();
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        if (shared->winner) return; // answered while the hedge was being decided on
+        shared->pending++;
+        shared->sessions[hedge ? 1 : 0] = &session;
+    }
+
+    std::chrono::milliseconds limit;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.attempts++;
+        limit = timeoutLocked();
+    }
+
+    auto start = requestClock::now();
+    httpResult result = session.get(url, limit, &shared->cancel, shared->callerCancel.get());
+    double ms = msSince(start);
+    bool answered = result.statusCode != 0;
+
+    if (answered) recordLatency(ms);
+    if (result.timedOut) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.timeouts++;
+    }
+
+    bool won = false;
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->pending--;
+        shared->sessions[hedge ? 1 : 0] = nullptr;
+        // An answer wins; a failure only once no other copy is still out
+        if (!shared->winner && (answered || shared->pending == 0)) {
+            shared->winner = std::move(result);
+            shared->hedgeWon = hedge;
+            shared->cancel.store(true, std::memory_order_relaxed);
+            shared->interruptAll();
+            won = true;
+        }
+    }
+    if (!won) return;
+    shared->decided.notify_all();
+
+    if (hedge && answered) {
+        // The first copy is cut off, but it took at least this long; leaving
+        // it out would hide exactly the tail the window is there to see
+        recordLatency(msSince(shared->start));
+        std::lock_guard<std::mutex> lock(mutex);
+        counters.hedgeWins++;
+    }
+}
+
+bool hedgedClient::takeHedgeToken() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (hedgeTokens < 1.0) {
+        counters.hedgesDenied++;
+        return false;
+    }
+    hedgeTokens -= 1.0;
+    counters.hedges++;
+    return true;
+}
+
+void hedgedClient::recordLatency(double ms) {
+    std::lock_guard<std::mutex> lock(mutex);
+    latencies[latencyNext] = ms;
+    latencyNext = (latencyNext + 1) % LATENCY_WINDOW;
+    latencyCount = std::min(latencyCount + 1, LATENCY_WINDOW);
+}
+
+double hedgedClient::percentile(double p) const {
+    std::vector<double> window(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(latencyCount));
+    auto rank = static_cast<size_t>(p * static_cast<double>(window.size() - 1) + 0.5);
+    std::nth_element(window.begin(), window.begin() + static_cast<std::ptrdiff_t>(rank), window.end());
+    return window[rank];
+}
+
+std::chrono::milliseconds hedgedClient::hedgeAfterLocked() const {
+    if (latencyCount < MIN_SAMPLES) return DEFAULT_HEDGE_AFTER;
+    auto p95 = std::chrono::milliseconds(static_cast<long long>(percentile(0.95)));
+    return std::max(MIN_HEDGE_AFTER, p95);
+}
+
+std::chrono::milliseconds hedgedClient::timeoutLocked() const {
+    if (latencyCount < MIN_SAMPLES) return DEFAULT_TIMEOUT;
+    auto scaled = std::chrono::milliseconds(static_cast<long long>(percentile(0.99) * TIMEOUT_P99_MULTIPLE));
+    return std::clamp(scaled, MIN_TIMEOUT, MAX_TIMEOUT);
+}
+
+std::chrono::milliseconds hedgedClient::hedgeAfter() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hedgeAfterLocked();
+}
+
+std::chrono::milliseconds hedgedClient::timeout() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return timeoutLocked();
+}
+
+hedgedClientStats hedgedClient::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    hedgedClientStats snapshot = counters;
+    snapshot.hedgeAfterMs = static_cast<double>(hedgeAfterLocked().count());
+    snapshot.timeoutMs = static_cast<double>(timeoutLocked().count());
+    return snapshot;
+}
@@ -0,0 +1,121 @@
+#ifndef HEDGED_CLIENT_H
+#define HEDGED_CLIENT_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "httpSession.h"
+
+struct hedgedClientStats {
+    uint64_t requests{0};      // get() calls
+    uint64_t attempts{0};      // requests actually sent, hedges and retries included
+    uint64_t hedges{0};        // duplicates sent because the first was slow
+    uint64_t hedgeWins{0};     // hedges that answered first
+    uint64_t hedgesDenied{0};  // slow requests that found the hedge budget spent
+    uint64_t retries{0};
+    uint64_t timeouts{0};      // attempts cut off by the adaptive timeout
+    double hedgeAfterMs{0};    // current thresholds, for logging
+    double timeoutMs{0};
+};
+
+// GETs with a deadline derived from recent latency, one hedged duplicate for
+// the slow ones, and retries for failures that are safe to repeat.
+//
+// The first copy of a request runs on the caller's thread, through that
+// thread's httpSession. One still unanswered after about the p95 of the
+// latency window gets a second copy from the hedge pool, HEDGE_THREADS
+// threads that each keep their own session until shutdown(), unless hedges
+// would exceed HEDGE_BUDGET of requests. Whichever copy answers first wins
+// and interrupts the other. Attempts are cut off after a few times the p99,
+// clamped to [MIN_TIMEOUT, MAX_TIMEOUT], and use the defaults until
+// MIN_SAMPLES responses have been seen.
+//
+// Only failures that never produced a response, timeouts, 429 and 5xx
+// gateway errors are retried, with full-jitter exponential backoff. A 404 or
+// any other answer goes straight back to the caller.
+//
+// A caller that no longer wants the answer can pass a cancel flag: once it
+// is set, get() returns a result marked cancelled within about CANCEL_POLL,
+// and no hedge or retry is sent. The hedge pool watches the flag and
+// interrupts the copies still out; with every hedge thread busy, libcurl
+// notices it on its own within a second.
+//
+// Safe to call from any number of threads.
+class hedgedClient {
+public:
+    static constexpr size_t LATENCY_WINDOW = 256;
+    static constexpr size_t MIN_SAMPLES = 20;
+    static constexpr std::chrono::milliseconds DEFAULT_HEDGE_AFTER{500};
+    static constexpr std::chrono::milliseconds MIN_HEDGE_AFTER{20};
+    static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{10000};
+    static constexpr std::chrono::milliseconds MIN_TIMEOUT{2000};
+    static constexpr std::chrono::milliseconds MAX_TIMEOUT{15000};
+    static constexpr double TIMEOUT_P99_MULTIPLE = 4.0;
+    static constexpr double HEDGE_BUDGET = 0.10; // hedges per request, long run
+    static constexpr double HEDGE_BURST = 5.0;   // hedges allowed back to back
+    static constexpr int MAX_ATTEMPTS = 3;       // first try plus retries
+    static constexpr std::chrono::milliseconds BACKOFF_BASE{100};
+    static constexpr std::chrono::milliseconds BACKOFF_CAP{2000};
+    static constexpr std::chrono::milliseconds CANCEL_POLL{20}; // how often a waiting get() checks the caller's flag
+    static constexpr size_t HEDGE_THREADS = 4;   // hedges in flight at once; more wait for a free thread
+
+    hedgedClient() = default;
+
+    hedgedClient(const hedgedClient&) = delete;
+    hedgedClient& operator=(const hedgedClient&) = delete;
+
+    httpResult get(const std::string& url, std::shared_ptr<const std::atomic<bool>> cancel = {});
+
+    // Off sends every attempt alone, e.g. to measure what hedging buys
+    void setHedging(bool enabled) { hedging.store(enabled, std::memory_order_relaxed); }
+
+    // From the latency window, or the defaults while it is still filling
+    [[nodiscard]] std::chrono::milliseconds hedgeAfter() const;
+    [[nodiscard]] std::chrono::milliseconds timeout() const;
+
+    [[nodiscard]] hedgedClientStats stats() const;
+
+    // Client used by fetchWordData
+    static hedgedClient& instance();
+
+    // Interrupts the hedges in flight and joins the hedge threads. Requests
+    // made afterwards, by any client, are sent without hedges.
+    static void shutdown();
+
+private:
+    // One get() and its copies
+    struct race;
+    // The hedge threads and the requests they are watching
+    class hedgePool;
+
+    httpResult getOnce(const std::string& url, const std::shared_ptr<const std::atomic<bool>>& cancel);
+    // Sends one copy from the calling thread's session and settles the race if it wins
+    void attempt(const std::shared_ptr<race>& shared, const std::string& url, bool hedge);
+    void sendHedge(const std::shared_ptr<race>& shared, const std::string& url);
+    void recordLatency(double ms);
+    bool takeHedgeToken();
+
+    // Caller holds mutex
+    [[nodiscard]] double percentile(double p) const;
+    [[nodiscard]] std::chrono::milliseconds hedgeAfterLocked() const;
+    [[nodiscard]] std::chrono::milliseconds timeoutLocked() const;
+
+    static bool retryable(const httpResult& result);
+    static bool isSet(const std::shared_ptr<const std::atomic<bool>>& cancel);
+
+    std::atomic<bool> hedging{true};
+
+    mutable std::mutex mutex;
+    std::array<double, LATENCY_WINDOW> latencies{};
+    size_t latencyCount = 0;
+    size_t latencyNext = 0;
+    double hedgeTokens = HEDGE_BURST;
+    hedgedClientStats counters;
+};
+
+#endif // HEDGED_CLIENT_H
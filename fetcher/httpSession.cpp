@@ -0,0 +1,194 @@
+#include "httpSession.h"
+
+#include <algorithm>
+#include <array>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr long DNS_CACHE_SECONDS = 600;
+constexpr std::chrono::milliseconds CONNECT_TIMEOUT{5000};
+
+// One share handle for the whole process. libcurl asks for a lock per data kind.
+class sharedCurlState {
+public:
+    sharedCurlState() {
+        share = curl_share_init();
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        // Connections themselves stay per thread: libcurl does not support
+        // sharing the connection cache between concurrent threads.
+    }
+
+    CURLSH* handle() const { return share; }
+
+    static sharedCurlState& instance() {
+        // Never destroyed: worker threads may still tear down their sessions during static destruction
+        static sharedCurlState* state = new sharedCurlState();
+        return *state;
+    }
+
+private:
+    CURLSH* share;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> locks;
+
+    static void lock(CURL*, curl_lock_data data, curl_lock_access, void* user) {
+        static_cast<sharedCurlState*>(user)->locks[data].lock();
+    }
+
+    static void unlock(CURL*, curl_lock_data data, void* user) {
+        static_cast<sharedCurlState*>(user)->locks[data].unlock();
+    }
+};
+
+double elapsedMs(CURL* handle, CURLINFO info) {
+    curl_off_t micros = 0;
+    curl_easy_getinfo(handle, info, &micros);
+    return static_cast<double>(micros) / 1000.0;
+}
+
+} // namespace
+
+std::mutex httpSession::statsMutex;
+httpSessionStats httpSession::stats;
+
+httpSession::httpSession() {
+    session.SetAcceptEncoding({cpr::AcceptEncodingMethods::gzip, cpr::AcceptEncodingMethods::deflate});
+
+    CURL* handle = session.GetCurlHolder()->handle;
+    curl_easy_setopt(handle, CURLOPT_SHARE, sharedCurlState::instance().handle());
+    curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, DNS_CACHE_SECONDS);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_SSL_SESSIONID_CACHE, 1L);
+
+    // Without one, a connect to an unreachable host waits out the OS default
+    session.SetConnectTimeout(cpr::ConnectTimeout{CONNECT_TIMEOUT});
+
+    // Sockets are tracked so interrupt() can reach them, and closed here so
+    // one is never shut down after its descriptor was handed out again
+    curl_easy_setopt(handle, CURLOPT_SOCKOPTFUNCTION, onSocketOpened);
+    curl_easy_setopt(handle, CURLOPT_SOCKOPTDATA, this);
+    curl_easy_setopt(handle, CURLOPT_CLOSESOCKETFUNCTION, onSocketClosing);
+    curl_easy_setopt(handle, CURLOPT_CLOSESOCKETDATA, this);
+}
+
+httpSession::~httpSession() {
+    curl_easy_setopt(session.GetCurlHolder()->handle, CURLOPT_SHARE, nullptr);
+}
+
+httpSession& httpSession::forThisThread() {
+    thread_local httpSession threadSession;
+    return threadSession;
+}
+
+int httpSession::onSocketOpened(void* user, curl_socket_t socket, curlsocktype purpose) {
+    if (purpose == CURLSOCKTYPE_IPCXN) {
+        auto* self = static_cast<httpSession*>(user);
+        std::lock_guard<std::mutex> lock(self->socketsMutex);
+        self->sockets.push_back(socket);
+    }
+    return CURL_SOCKOPT_OK;
+}
+
+int httpSession::onSocketClosing(void* user, curl_socket_t socket) {
+    auto* self = static_cast<httpSession*>(user);
+    std::lock_guard<std::mutex> lock(self->socketsMutex);
+    self->sockets.erase(std::remove(self->sockets.begin(), self->sockets.end(), socket), self->sockets.end());
+#if defined(_WIN32)
+    return closesocket(socket);
+#else
+    return close(socket);
+#endif
+}
+
+void httpSession::interrupt() {
+    std::lock_guard<std::mutex> lock(socketsMutex);
+    for (curl_socket_t socket : sockets) {
+#if defined(_WIN32)
+        shutdown(socket, SD_BOTH);
+#else
+        shutdown(socket, SHUT_RDWR);
+#endif
+    }
+}
+
+httpResult httpSession::get(const std::string& url) {
+    return get(url, std::chrono::milliseconds{0}, nullptr);
+}
+
+httpResult httpSession::get(const std::string& url, std::chrono::milliseconds timeout,
+                            const std::atomic<bool>* cancel, const std::atomic<bool>* alsoCancel) {
+    auto isCancelled = [cancel, alsoCancel]() {
+        return (cancel != nullptr && cancel->load(std::memory_order_relaxed)) ||
+               (alsoCancel != nullptr && alsoCancel->load(std::memory_order_relaxed));
+    };
+
+    session.SetUrl(cpr::Url{url});
+    session.SetTimeout(cpr::Timeout{timeout});
+    // Replaced on every request, so the previous call's flag is never read
+    session.SetProgressCallback(cpr::ProgressCallback{[isCancelled](auto, auto, auto, auto, auto) {
+        return !isCancelled();
+    }});
+    cpr::Response r = session.Get();
+
+    httpResult result;
+    result.statusCode = r.status_code;
+    result.body = std::move(r.text);
+    if (r.error) result.error = r.error.message;
+    result.timedOut = r.error.code == cpr::ErrorCode::OPERATION_TIMEDOUT;
+    result.cancelled = r.error && isCancelled();
+
+    // Timestamps from libcurl are cumulative from the start of the request
+    CURL* handle = session.GetCurlHolder()->handle;
+    double dns = elapsedMs(handle, CURLINFO_NAMELOOKUP_TIME_T);
+    double connect = elapsedMs(handle, CURLINFO_CONNECT_TIME_T);
+    double tls = elapsedMs(handle, CURLINFO_APPCONNECT_TIME_T);
+    double firstByte = elapsedMs(handle, CURLINFO_STARTTRANSFER_TIME_T);
+    double total = elapsedMs(handle, CURLINFO_TOTAL_TIME_T);
+
+    long newConnections = 0;
+    curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &newConnections);
+
+    requestTiming& timing = result.timing;
+    timing.dnsMs = dns;
+    timing.connectMs = connect > dns ? connect - dns : 0.0;
+    timing.tlsMs = tls > connect ? tls - connect : 0.0;
+    double requestSent = tls > 0.0 ? tls : connect;
+    timing.ttfbMs = firstByte > requestSent ? firstByte - requestSent : 0.0;
+    timing.transferMs = total > firstByte ? total - firstByte : 0.0;
+    timing.totalMs = total;
+    timing.reusedConnection = newConnections == 0 && !r.error;
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.requests++;
+        if (timing.reusedConnection) stats.reusedConnections++;
+        stats.dnsMs += timing.dnsMs;
+        stats.connectMs += timing.connectMs;
+        stats.tlsMs += timing.tlsMs;
+        stats.ttfbMs += timing.ttfbMs;
+        stats.transferMs += timing.transferMs;
+        stats.totalMs += timing.totalMs;
+    }
+
+    return result;
+}
+
+httpSessionStats httpSession::totals() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return stats;
+}
+
+void httpSession::resetTotals() {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats = httpSessionStats{};
+}
@@ -0,0 +1,93 @@
+#ifndef HTTP_SESSION_H
+#define HTTP_SESSION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "fetcher.h" // cpr with the Windows.h workarounds
+
+// Where the time of one request went, in milliseconds. Phases that were
+// skipped because the connection was reused are zero.
+struct requestTiming {
+    double dnsMs{0};
+    double connectMs{0};
+    double tlsMs{0};
+    double ttfbMs{0};     // request sent until the first response byte
+    double transferMs{0}; // first byte until the body is complete
+    double totalMs{0};
+    bool reusedConnection{false};
+};
+
+struct httpResult {
+    long statusCode{0};
+    std::string body;
+    std::string error; // empty unless the request failed below HTTP
+    bool timedOut{false};
+    bool cancelled{false};
+    requestTiming timing;
+};
+
+// Running totals over every request made through any session
+struct httpSessionStats {
+    uint64_t requests{0};
+    uint64_t reusedConnections{0};
+    double dnsMs{0};
+    double connectMs{0};
+    double tlsMs{0};
+    double ttfbMs{0};
+    double transferMs{0};
+    double totalMs{0};
+};
+
+// Long-lived HTTP client. Each thread gets its own curl handle that keeps its
+// connections alive between requests, and all of them share one DNS cache and
+// TLS session cache, so repeat lookups skip resolution and full handshakes.
+// Responses may be gzip-compressed and are decoded transparently.
+class httpSession {
+public:
+    httpSession();
+    ~httpSession();
+
+    httpSession(const httpSession&) = delete;
+    httpSession& operator=(const httpSession&) = delete;
+
+    httpResult get(const std::string& url);
+
+    // Gives up after timeout (zero waits forever), or soon after either cancel
+    // flag turns true. libcurl only checks them between reads and about once a
+    // second while waiting, so it frees the connection rather than the caller;
+    // set a flag and then call interrupt() to end the request at once.
+    httpResult get(const std::string& url, std::chrono::milliseconds timeout, const std::atomic<bool>* cancel,
+                   const std::atomic<bool>* alsoCancel = nullptr);
+
+    // Shuts down every connection this session has open, so a get() running
+    // on its thread fails immediately instead of at libcurl's next check.
+    // Callable from any thread while the session is alive; the connections
+    // are lost, and the next request opens a new one.
+    void interrupt();
+
+    // Session owned by the calling thread
+    static httpSession& forThisThread();
+
+    static httpSessionStats totals();
+    static void resetTotals();
+
+private:
+    // Declared before the session: closing its connections reports back here
+    std::mutex socketsMutex;
+    std::vector<curl_socket_t> sockets;
+
+    cpr::Session session;
+
+    static int onSocketOpened(void* user, curl_socket_t socket, curlsocktype purpose);
+    static int onSocketClosing(void* user, curl_socket_t socket);
+
+    static std::mutex statsMutex;
+    static httpSessionStats stats;
+};
+
+#endif // HTTP_SESSION_H
@@ -0,0 +1,292 @@
+#include "lexicon.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t LEXICON_MAGIC = 0x584C4344; // "DCLX"
+constexpr uint32_t LEXICON_VERSION = 1;
+
+struct lexiconHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t indexOffset;
+    uint32_t entriesOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+};
+
+constexpr size_t INDEX_STRIDE = 3; // keyOffset, keyLength, entryOffset
+constexpr size_t ENTRY_HEADER_WORDS = 6; // word and phonetic pairs, posCount, defCount
+
+std::string lexiconPath = "dictionary.lex";
+
+} // namespace
+
+void lexicon::configure(const std::string& path) {
+    lexiconPath = path;
+}
+
+lexicon& lexicon::instance() {
+    static lexicon offline;
+    static bool opened = [] {
+        std::error_code error;
+        return std::filesystem::exists(lexiconPath, error) && offline.open(lexiconPath);
+    }();
+    (void)opened;
+    return offline;
+}
+
+bool lexicon::open(const std::string& path) {
+    close();
+    if (!file.open(path, false) || file.size() < sizeof(lexiconHeader)) {
+        close();
+        return false;
+    }
+
+    lexiconHeader head;
+    std::memcpy(&head, file.data(), sizeof(head));
+
+    uint64_t indexEnd = uint64_t{head.indexOffset} + uint64_t{head.entryCount} * INDEX_STRIDE * sizeof(uint32_t);
+    bool valid = head.magic == LEXICON_MAGIC &&
+                 head.version == LEXICON_VERSION &&
+                 head.indexOffset % 4 == 0 && head.entriesOffset % 4 == 0 &&
+                 indexEnd <= head.entriesOffset &&
+                 head.entriesOffset <= head.stringsOffset &&
+                 uint64_t{head.stringsOffset} + head.stringsSize <= file.size();
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    count = head.entryCount;
+    entriesSize = head.stringsOffset - head.entriesOffset;
+    stringsSize = head.stringsSize;
+    index = reinterpret_cast<const uint32_t*>(file.data() + head.indexOffset);
+    entries = reinterpret_cast<const uint32_t*>(file.data() + head.entriesOffset);
+    strings = reinterpret_cast<const char*>(file.data() + head.stringsOffset);
+
+    // Every key inside the string pool and every entry record starting inside
+    // the entries section; the lists an entry points at are checked by find()
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t* item = index + i * INDEX_STRIDE;
+        bool inside = uint64_t{item[0]} + item[1] <= stringsSize &&
+                      item[2] % 4 == 0 &&
+                      uint64_t{item[2]} + ENTRY_HEADER_WORDS * sizeof(uint32_t) <= entriesSize;
+        if (!inside) {
+            std::cerr << "Lexicon " << path << " is corrupt (index record " << i << ")" << std::endl;
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void lexicon::close() {
+    file.close();
+    index = nullptr;
+    entries = nullptr;
+    strings = nullptr;
+    count = 0;
+    entriesSize = 0;
+    stringsSize = 0;
+}
+
+std::string_view lexicon::stringAt(uint32_t offset, uint32_t length) const {
+    if (uint64_t{offset} + length > stringsSize) return {};
+    return {strings + offset, length};
+}
+
+std::string_view lexicon::keyAt(size_t i) const {
+    const uint32_t* item = index + i * INDEX_STRIDE;
+    return stringAt(item[0], item[1]);
+}
+
+size_t lexicon::lowerBound(std::string_view key) const {
+    size_t low = 0;
+    size_t high = count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (keyAt(mid) < key) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+std::optional<WordData> lexicon::find(const std::string& key) const {
+    if (!isOpen()) return std::nullopt;
+
+    size_t i = lowerBound(key);
+    if (i >= count || keyAt(i) != key) return std::nullopt;
+
+    uint32_t entryOffset = index[i * INDEX_STRIDE + 2];
+    const uint32_t* entry = entries + entryOffset / sizeof(uint32_t);
+    uint32_t posCount = entry[4];
+    uint32_t defCount = entry[5];
+
+    // Both lists of {offset, length} pairs have to end inside the entries section
+    uint64_t entryEnd = uint64_t{entryOffset} +
+                        (ENTRY_HEADER_WORDS + 2 * (uint64_t{posCount} + defCount)) * sizeof(uint32_t);
+    if (entryEnd > entriesSize) return std::nullopt;
+
+    WordData data;
+    data.word = stringAt(entry[0], entry[1]);
+    data.phonetic = stringAt(entry[2], entry[3]);
+
+    const uint32_t* list = entry + ENTRY_HEADER_WORDS;
+    data.posList.reserve(posCount);
+    for (uint32_t p = 0; p < posCount; ++p, list += 2) {
+        data.posList.emplace_back(stringAt(list[0], list[1]));
+    }
+
+    data.definitionList.reserve(defCount);
+    for (uint32_t d = 0; d < defCount; ++d, list += 2) {
+        data.definitionList.emplace_back(stringAt(list[0], list[1]));
+    }
+
+    return data;
+}
+
+bool lexiconBuilder::appendString(const std::string& text) {
+    if (pool.size() + text.size() > std::numeric_limits<uint32_t>::max()) return false;
+
+    entryWords.push_back(static_cast<uint32_t>(pool.size()));
+    entryWords.push_back(static_cast<uint32_t>(text.size()));
+    pool += text;
+    return true;
+}
+
+bool lexiconBuilder::add(const WordData& data) {
+    std::string key = normalizeWord(data.word);
+    if (key.empty()) return false;
+    if (!seenKeys.insert(key).second) {
+        duplicateCount++;
+        return false;
+    }
+
+    if (entryWords.size() * sizeof(uint32_t) > std::numeric_limits<uint32_t>::max()) return false;
+    uint32_t entryOffset = static_cast<uint32_t>(entryWords.size() * sizeof(uint32_t));
+
+    bool fits = appendString(data.word) && appendString(data.phonetic);
+    entryWords.push_back(static_cast<uint32_t>(data.posList.size()));
+    entryWords.push_back(static_cast<uint32_t>(data.definitionList.size()));
+
+    for (const auto& pos : data.posList) fits = fits && appendString(pos);
+    for (const auto& def : data.definitionList) fits = fits && appendString(def);
+    if (!fits) return false;
+
+    keys.push_back(pendingKey{std::move(key), entryOffset});
+    return true;
+}
+
+bool lexiconBuilder::write(const std::string& path) {
+    std::sort(keys.begin(), keys.end(),
+        [](const pendingKey& a, const pendingKey& b) { return a.key < b.key; });
+
+    // Keys go at the end of the string pool
+    std::string keyText;
+    std::vector<uint32_t> indexWords;
+    indexWords.reserve(keys.size() * INDEX_STRIDE);
+    for (const auto& item : keys) {
+        uint64_t keyOffset = pool.size() + keyText.size();
+        if (keyOffset + item.key.size() > std::numeric_limits<uint32_t>::max()) return false;
+        indexWords.push_back(static_cast<uint32_t>(keyOffset));
+        indexWords.push_back(static_cast<uint32_t>(item.key.size()));
+        indexWords.push_back(item.entryOffset);
+        keyText += item.key;
+    }
+
+    uint64_t indexOffset = sizeof(lexiconHeader) + (4 - sizeof(lexiconHeader) % 4) % 4;
+    uint64_t entriesOffset = indexOffset + indexWords.size() * sizeof(uint32_t);
+    uint64_t stringsOffset = entriesOffset + entryWords.size() * sizeof(uint32_t);
+    uint64_t stringsSize = pool.size() + keyText.size();
+    if (stringsOffset + stringsSize > std::numeric_limits<uint32_t>::max()) return false;
+
+    lexiconHeader head{
+        LEXICON_MAGIC,
+        LEXICON_VERSION,
+        static_cast<uint32_t>(keys.size()),
+        static_cast<uint32_t>(indexOffset),
+        static_cast<uint32_t>(entriesOffset),
+        static_cast<uint32_t>(stringsOffset),
+        static_cast<uint32_t>(stringsSize)
+    };
+
+    // Written to a temp file and renamed, so a running app never maps a half-written lexicon
+    std::string tempPath = path + ".tmp";
+    std::FILE* out = std::fopen(tempPath.c_str(), "wb");
+    if (!out) return false;
+
+    const char padding[4] = {};
+    bool written = std::fwrite(&head, sizeof(head), 1, out) == 1 &&
+                   std::fwrite(padding, 1, indexOffset - sizeof(head), out) == indexOffset - sizeof(head) &&
+                   std::fwrite(indexWords.data(), sizeof(uint32_t), indexWords.size(), out) == indexWords.size() &&
+                   std::fwrite(entryWords.data(), sizeof(uint32_t), entryWords.size(), out) == entryWords.size() &&
+                   std::fwrite(pool.data(), 1, pool.size(), out) == pool.size() &&
+                   std::fwrite(keyText.data(), 1, keyText.size(), out) == keyText.size() &&
+                   syncFile(out);
+    std::fclose(out);
+
+    std::error_code error;
+    if (written) std::filesystem::rename(tempPath, path, error);
+    if (!written || error) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void lexiconBuilder::addJson(const nlohmann::json& value, long long& seen) {
+    if (value.is_array()) {
+        for (const auto& item : value) addJson(item, seen);
+        return;
+    }
+    if (!value.is_object() || !value.contains("word")) return;
+
+    WordData data;
+    parseWordEntry(value, data);
+    add(data);
+    seen++;
+}
+
+long long lexiconBuilder::importDump(const std::string& dumpPath) {
+    std::ifstream in(dumpPath, std::ios::binary);
+    if (!in) return -1;
+
+    std::string extension = std::filesystem::path(dumpPath).extension().string();
+    long long seen = 0;
+
+    if (extension == ".ndjson" || extension == ".jsonl") {
+        std::string line;
+        size_t lineNumber = 0;
+        while (std::getline(in, line)) {
+            lineNumber++;
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+            try {
+                addJson(nlohmann::json::parse(line), seen);
+            }
+            catch (const nlohmann::json::exception& e) {
+                std::cerr << dumpPath << ":" << lineNumber << ": " << e.what() << std::endl;
+            }
+        }
+    }
+    else {
+        try {
+            addJson(nlohmann::json::parse(in), seen);
+        }
+        catch (const nlohmann::json::exception& e) {
+            std::cerr << dumpPath << ": " << e.what() << std::endl;
+            return -1;
+        }
+    }
+
+    return seen;
+}
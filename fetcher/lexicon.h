@@ -0,0 +1,97 @@
+#ifndef LEXICON_H
+#define LEXICON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "fetcher.h"
+#include "mappedFile.h"
+
+// Read-only offline dictionary compiled by tools/lexiconImport.
+//
+// Layout (all integers little-endian uint32, every section 4-byte aligned):
+//   header    magic, version, entryCount, indexOffset, entriesOffset, stringsOffset, stringsSize
+//   index     entryCount x {keyOffset, keyLength, entryOffset}, sorted by key
+//   entries   {word, phonetic, posCount, defCount, pos..., def...} where every
+//             string is an {offset, length} pair into the string pool
+//   strings   UTF-8 text, not NUL terminated
+//
+// The file is memory-mapped and lookups are a binary search over the index;
+// nothing is parsed at lookup time. open() checks the header and every index
+// record against the file size, find() checks the entry it reads, so a
+// truncated or corrupt file is rejected or misses instead of reading past
+// the mapping.
+class lexicon {
+public:
+    lexicon() = default;
+
+    bool open(const std::string& path);
+    void close();
+    [[nodiscard]] bool isOpen() const { return file.data() != nullptr; }
+
+    // Key must already be normalized
+    std::optional<WordData> find(const std::string& key) const;
+
+    // Sorted headword access, used for prefix queries
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] std::string_view keyAt(size_t i) const;
+    [[nodiscard]] size_t lowerBound(std::string_view key) const;
+
+    // Where instance() looks for the lexicon. Only has an effect before the first instance() call.
+    static void configure(const std::string& path);
+
+    // Offline tier consulted by fetchWordData. Stays closed if the file does not exist.
+    static lexicon& instance();
+
+private:
+    mappedFile file;
+    const uint32_t* index{nullptr};
+    const uint32_t* entries{nullptr};
+    const char* strings{nullptr};
+    size_t count{0};
+    uint32_t entriesSize{0}; // bytes between entriesOffset and stringsOffset
+    uint32_t stringsSize{0};
+
+    [[nodiscard]] std::string_view stringAt(uint32_t offset, uint32_t length) const;
+};
+
+// Accumulates WordData entries and writes them out in the lexicon format.
+class lexiconBuilder {
+public:
+    // First entry for a normalized headword wins, like fetchWordData taking jsonData[0]
+    bool add(const WordData& data);
+    bool write(const std::string& path);
+
+    // Adds every entry of a dump in the API's JSON shape. A .ndjson / .jsonl file holds
+    // one API response (or one entry) per line, anything else is a single JSON array.
+    // Returns the number of entries read, or -1 if the file cannot be read.
+    long long importDump(const std::string& dumpPath);
+
+    [[nodiscard]] size_t size() const { return keys.size(); }
+
+    // add() calls turned away because the headword was already added
+    [[nodiscard]] size_t duplicates() const { return duplicateCount; }
+
+private:
+    struct pendingKey {
+        std::string key;
+        uint32_t entryOffset;
+    };
+
+    // Text and entry records are appended as entries arrive, only the keys get sorted
+    std::vector<pendingKey> keys;
+    std::unordered_set<std::string> seenKeys;
+    std::vector<uint32_t> entryWords;
+    std::string pool;
+    size_t duplicateCount = 0;
+
+    bool appendString(const std::string& text);
+    void addJson(const nlohmann::json& value, long long& seen);
+};
+
+#endif // LEXICON_H
@@ -0,0 +1,78 @@
+#include "lookupPrefetcher.h"
+
+#include <algorithm>
+
+lookupPrefetcher::lookupPrefetcher(lookupWorker& worker, std::chrono::milliseconds debounce)
+    : worker(worker), interval(debounce) {}
+
+void lookupPrefetcher::setDebounce(std::chrono::milliseconds debounce) {
+    interval = std::max(debounce, std::chrono::milliseconds(0));
+}
+
+void lookupPrefetcher::setFilter(std::function<bool(const std::string&)> accept) {
+    filter = std::move(accept);
+}
+
+void lookupPrefetcher::update(const std::string& text, double now) {
+    std::string normalized = normalizeWord(text);
+
+    if (normalized != query) {
+        query = std::move(normalized);
+        changedAt = now;
+        submitted = false;
+
+        // Typing on makes the old prefix useless; coming back to it restarts the wait
+        if (prefetch.valid() && prefetch.word != query) drop(counters.superseded);
+    }
+
+    if (submitted || query.empty() || interval.count() == 0) return;
+    if (now - changedAt < intervalSeconds()) return;
+
+    submitted = true;
+    if (prefetch.valid()) return; // already prefetched this very word
+    if (filter && !filter(query)) return;
+
+    prefetch = worker.submit(query, lookupPriority::Prefetch);
+    counters.issued++;
+}
+
+double lookupPrefetcher::secondsUntilDue(double now) const {
+    if (submitted || query.empty() || interval.count() == 0) return -1.0;
+    return std::max(0.0, intervalSeconds() - (now - changedAt));
+}
+
+double lookupPrefetcher::intervalSeconds() const {
+    return std::chrono::duration<double>(interval).count();
+}
+
+lookupHandle lookupPrefetcher::take(const std::string& word) {
+    if (!prefetch.valid() || prefetch.word != normalizeWord(word)) {
+        counters.missed++;
+        if (prefetch.valid()) drop(counters.superseded);
+        return {};
+    }
+
+    lookupHandle handle = std::move(prefetch);
+    prefetch = lookupHandle{};
+
+    if (handle.ready()) {
+        counters.usedReady++;
+    }
+    else {
+        worker.promote(handle);
+        counters.usedInFlight++;
+    }
+    return handle;
+}
+
+void lookupPrefetcher::cancel() {
+    if (prefetch.valid()) drop(counters.abandoned);
+    query.clear();
+    submitted = false;
+}
+
+void lookupPrefetcher::drop(unsigned long long& reason) {
+    prefetch.cancel();
+    prefetch = lookupHandle{};
+    reason++;
+}
@@ -0,0 +1,83 @@
+#ifndef LOOKUP_PREFETCHER_H
+#define LOOKUP_PREFETCHER_H
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "lookupWorker.h"
+
+struct lookupPrefetcherStats {
+    unsigned long long issued{0};        // prefetches submitted to the worker
+    unsigned long long usedReady{0};     // committed word had already been fetched
+    unsigned long long usedInFlight{0};  // committed word was still queued or on the network
+    unsigned long long superseded{0};    // dropped because the query moved on
+    unsigned long long abandoned{0};     // dropped by cancel() without the word being committed
+    unsigned long long missed{0};        // commits with no prefetch for the word
+
+    [[nodiscard]] unsigned long long used() const { return usedReady + usedInFlight; }
+    [[nodiscard]] double usefulRate() const {
+        return issued > 0 ? static_cast<double>(used()) / static_cast<double>(issued) : 0.0;
+    }
+};
+
+// Speculative lookups for a word that is still being typed. Once the query
+// has not changed for the debounce interval it goes to the lookupWorker at
+// prefetch priority, behind any real lookup. A newer query cancels the old
+// prefetch, which the worker skips if it has not started yet.
+//
+// When the user commits, take() hands over the prefetch for that word,
+// finished or not, and promotes it to normal priority if it is still queued.
+//
+// Time comes from the caller, in seconds on the clock its input runs on
+// (Input::time() in the app), so a replayed recording prefetches at the
+// same points as the session it was recorded from.
+//
+// Render thread only.
+class lookupPrefetcher {
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_DEBOUNCE{250};
+
+    explicit lookupPrefetcher(lookupWorker& worker, std::chrono::milliseconds debounce = DEFAULT_DEBOUNCE);
+
+    // Zero turns prefetching off
+    void setDebounce(std::chrono::milliseconds interval);
+    [[nodiscard]] std::chrono::milliseconds debounce() const { return interval; }
+
+    // Words the filter rejects (normalized, e.g. known misspellings) are never prefetched
+    void setFilter(std::function<bool(const std::string&)> accept);
+
+    // Call with the current query whenever it may have changed; every frame is fine.
+    // Submits the query once it has been stable for the debounce interval.
+    void update(const std::string& query, double now);
+
+    // Seconds from now until update() would submit, negative when nothing is
+    // waiting. Lets an event-driven loop sleep until then.
+    [[nodiscard]] double secondsUntilDue(double now) const;
+
+    // The prefetch for word if there is one, otherwise an invalid handle
+    lookupHandle take(const std::string& word);
+
+    // Drops any prefetch still held, e.g. when the search screen is left
+    void cancel();
+
+    [[nodiscard]] const lookupPrefetcherStats& stats() const { return counters; }
+
+private:
+    lookupWorker& worker;
+    std::chrono::milliseconds interval;
+    std::function<bool(const std::string&)> filter;
+
+    std::string query;            // normalized
+    double changedAt{0.0};        // when query last changed, on the caller's clock
+    bool submitted{false};        // query has been dealt with, prefetched or filtered out
+
+    lookupHandle prefetch;        // word is normalized
+
+    lookupPrefetcherStats counters;
+
+    void drop(unsigned long long& reason);
+    [[nodiscard]] double intervalSeconds() const;
+};
+
+#endif // LOOKUP_PREFETCHER_H
@@ -0,0 +1,123 @@
+#include "lookupWorker.h"
+
+#include <algorithm>
+
+lookupWorker::lookupWorker(size_t threadCount) {
+    if (threadCount == 0) threadCount = 1;
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+lookupWorker::~lookupWorker() {
+    shutdown();
+}
+
+void lookupWorker::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        // Aborts their requests instead of waiting out timeouts and retries
+        for (auto& cancelled : running) cancelled->store(true);
+    }
+    wakeUp.notify_all();
+
+    for (auto& thread : threads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+lookupWorker& lookupWorker::instance() {
+    static lookupWorker worker;
+    return worker;
+}
+
+lookupHandle lookupWorker::submit(const std::string& word, lookupPriority priority) {
+    job newJob;
+    newJob.word = word;
+    newJob.cancelled = std::make_shared<std::atomic<bool>>(false);
+
+    lookupHandle handle;
+    handle.word = word;
+    handle.result = newJob.promise.get_future().share();
+    handle.cancelled = newJob.cancelled;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        handle.id = nextId++;
+        newJob.id = handle.id;
+
+        if (priority == lookupPriority::Prefetch) prefetches.push_back(std::move(newJob));
+        else jobs.push_back(std::move(newJob));
+    }
+    wakeUp.notify_one();
+
+    return handle;
+}
+
+bool lookupWorker::promote(const lookupHandle& handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = std::find_if(prefetches.begin(), prefetches.end(),
+                           [&handle](const job& queued) { return queued.id == handle.id; });
+    if (it == prefetches.end()) return false;
+
+    jobs.push_back(std::move(*it));
+    prefetches.erase(it);
+    return true;
+}
+
+void lookupWorker::setCompletionListener(std::function<void()> listener) {
+    std::lock_guard<std::mutex> lock(mutex);
+    completionListener = std::move(listener);
+}
+
+bool lookupWorker::idle() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.empty() && prefetches.empty() && running.empty();
+}
+
+void lookupWorker::workerLoop() {
+    while (true) {
+        job current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this]() { return stopping || !jobs.empty() || !prefetches.empty(); });
+
+            // Queued lookups are abandoned on shutdown, nobody is left to read them
+            if (stopping) return;
+
+            std::deque<job>& queue = jobs.empty() ? prefetches : jobs;
+            current = std::move(queue.front());
+            queue.pop_front();
+            running.push_back(current.cancelled);
+        }
+
+        auto finish = [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            running.erase(std::find(running.begin(), running.end(), current.cancelled));
+        };
+
+        if (current.cancelled->load()) {
+            // Nobody is waiting for this word any more
+            current.promise.set_value(WordData{});
+            finish();
+            continue;
+        }
+
+        try {
+            current.promise.set_value(fetchWordData(current.word, current.cancelled));
+        }
+        catch (...) {
+            current.promise.set_exception(std::current_exception());
+        }
+
+        std::function<void()> listener;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            listener = completionListener;
+        }
+        if (listener) listener();
+        finish();
+    }
+}
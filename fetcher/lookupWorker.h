@@ -0,0 +1,97 @@
+#ifndef LOOKUP_WORKER_H
+#define LOOKUP_WORKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fetcher.h"
+
+// Handle to a lookup running on the worker. Cheap to copy; the result is
+// shared, so any number of holders can poll it from the render thread.
+struct lookupHandle {
+    uint64_t id{0};
+    std::string word;
+    std::shared_future<WordData> result;
+    std::shared_ptr<std::atomic<bool>> cancelled;
+
+    [[nodiscard]] bool valid() const { return result.valid(); }
+    [[nodiscard]] bool ready() const {
+        return result.valid() &&
+               result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    // A cancelled lookup that has not started yet is skipped by the worker.
+    // One that is already on the network is aborted and resolves to a
+    // placeholder marked cancelled.
+    void cancel() const {
+        if (cancelled) cancelled->store(true);
+    }
+};
+
+// Prefetches only run when no regular lookup is waiting
+enum class lookupPriority { Normal, Prefetch };
+
+// Runs fetchWordData on background threads so the raylib loop never blocks on HTTP.
+class lookupWorker {
+public:
+    explicit lookupWorker(size_t threadCount = 2);
+    ~lookupWorker(); // shutdown()
+
+    lookupWorker(const lookupWorker&) = delete;
+    lookupWorker& operator=(const lookupWorker&) = delete;
+
+    lookupHandle submit(const std::string& word, lookupPriority priority = lookupPriority::Normal);
+
+    // Moves a queued prefetch up to normal priority once someone is waiting
+    // for it. False when it has already started (or finished).
+    bool promote(const lookupHandle& handle);
+
+    // Called on the worker thread after each lookup's result is ready, so a
+    // waiting UI can wake up. Not called for lookups skipped after cancel().
+    void setCompletionListener(std::function<void()> listener);
+
+    // Nothing queued or running. A lookup counts as running until its
+    // completion listener has returned, so once this is true no listener
+    // call is still to come.
+    [[nodiscard]] bool idle() const;
+
+    // Cancels the lookups in progress, abandons the queued ones and joins the
+    // threads. Call it while the caches the lookups use are still alive: the
+    // process-wide worker is a function-local static that may be destroyed
+    // after them. Later submits are never run. Safe to call more than once.
+    void shutdown();
+
+    // Process-wide worker shared by the screens
+    static lookupWorker& instance();
+
+private:
+    struct job {
+        uint64_t id{0};
+        std::string word;
+        std::promise<WordData> promise;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    std::vector<std::thread> threads;
+    std::deque<job> jobs;
+    std::deque<job> prefetches;
+    std::vector<std::shared_ptr<std::atomic<bool>>> running; // cancel flags of the jobs being looked up
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool stopping{false};
+    uint64_t nextId{1};
+    std::function<void()> completionListener;
+
+    void workerLoop();
+};
+
+#endif // LOOKUP_WORKER_H
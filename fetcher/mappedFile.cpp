@@ -0,0 +1,262 @@
+#include "mappedFile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+mappedFile::~mappedFile() {
+    close();
+}
+
+fileLock::~fileLock() {
+    unlock();
+}
+
+mappedFile::mappedFile(mappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+mappedFile& mappedFile::operator=(mappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        view = std::exchange(other.view, nullptr);
+        length = std::exchange(other.length, 0);
+        writable = std::exchange(other.writable, false);
+        opened = std::exchange(other.opened, false);
+#if defined(_WIN32)
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#else
+        fd = std::exchange(other.fd, -1);
+#endif
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+
+bool mappedFile::open(const std::string& path, bool write) {
+    close();
+    writable = write;
+
+    HANDLE handle = CreateFileA(path.c_str(),
+        writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        writable ? OPEN_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        CloseHandle(handle);
+        return false;
+    }
+
+    fileHandle = handle;
+    length = static_cast<uint64_t>(fileSize.QuadPart);
+    opened = true;
+
+    if (!map()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool mappedFile::map() {
+    if (length == 0) return true;
+
+    HANDLE mapping = CreateFileMappingA(static_cast<HANDLE>(fileHandle), nullptr,
+        writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) return false;
+
+    void* address = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    if (!address) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    mappingHandle = mapping;
+    view = static_cast<uint8_t*>(address);
+    return true;
+}
+
+void mappedFile::unmap() {
+    if (view) UnmapViewOfFile(view);
+    if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+    view = nullptr;
+    mappingHandle = nullptr;
+}
+
+bool mappedFile::resize(uint64_t newSize) {
+    if (!opened || !writable) return false;
+
+    unmap();
+
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(newSize);
+    if (!SetFilePointerEx(static_cast<HANDLE>(fileHandle), position, nullptr, FILE_BEGIN) ||
+        !SetEndOfFile(static_cast<HANDLE>(fileHandle))) {
+        map();
+        return false;
+    }
+
+    length = newSize;
+    return map();
+}
+
+bool mappedFile::flush() {
+    if (!view || !writable) return true;
+    return FlushViewOfFile(view, 0) && FlushFileBuffers(static_cast<HANDLE>(fileHandle));
+}
+
+void mappedFile::close() {
+    unmap();
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+    fileHandle = nullptr;
+    length = 0;
+    opened = false;
+}
+
+bool fileLock::tryLock(const std::string& path) {
+    unlock();
+
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    OVERLAPPED whole{};
+    if (!LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, MAXDWORD, MAXDWORD, &whole)) {
+        CloseHandle(handle);
+        return false;
+    }
+
+    fileHandle = handle;
+    locked = true;
+    return true;
+}
+
+void fileLock::unlock() {
+    // Closing the handle releases the lock
+    if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+    fileHandle = nullptr;
+    locked = false;
+}
+
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+    return _commit(_fileno(file)) == 0;
+}
+
+#else
+
+bool mappedFile::open(const std::string& path, bool write) {
+    close();
+    writable = write;
+
+    int handle = ::open(path.c_str(), writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (handle < 0) return false;
+
+    struct stat info {};
+    if (fstat(handle, &info) != 0) {
+        ::close(handle);
+        return false;
+    }
+
+    fd = handle;
+    length = static_cast<uint64_t>(info.st_size);
+    opened = true;
+
+    if (!map()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool mappedFile::map() {
+    if (length == 0) return true;
+
+    void* address = mmap(nullptr, length, writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+        MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) return false;
+
+    view = static_cast<uint8_t*>(address);
+    return true;
+}
+
+void mappedFile::unmap() {
+    if (view) munmap(view, length);
+    view = nullptr;
+}
+
+bool mappedFile::resize(uint64_t newSize) {
+    if (!opened || !writable) return false;
+
+    unmap();
+    if (ftruncate(fd, static_cast<off_t>(newSize)) != 0) {
+        map();
+        return false;
+    }
+
+    length = newSize;
+    return map();
+}
+
+bool mappedFile::flush() {
+    if (!view || !writable) return true;
+    return msync(view, length, MS_SYNC) == 0;
+}
+
+void mappedFile::close() {
+    unmap();
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    length = 0;
+    opened = false;
+}
+
+bool fileLock::tryLock(const std::string& path) {
+    unlock();
+
+    int handle = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (handle < 0) return false;
+
+    if (flock(handle, LOCK_EX | LOCK_NB) != 0) {
+        ::close(handle);
+        return false;
+    }
+
+    fd = handle;
+    locked = true;
+    return true;
+}
+
+void fileLock::unlock() {
+    // Closing the descriptor releases the lock
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    locked = false;
+}
+
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) return false;
+    return fsync(fileno(file)) == 0;
+}
+
+#endif
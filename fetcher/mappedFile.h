@@ -0,0 +1,81 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Thin memory-mapping wrapper over mmap / MapViewOfFile.
+// The whole file is mapped; writable mappings are shared with the file on disk.
+class mappedFile {
+public:
+    mappedFile() = default;
+    ~mappedFile();
+
+    mappedFile(const mappedFile&) = delete;
+    mappedFile& operator=(const mappedFile&) = delete;
+    mappedFile(mappedFile&& other) noexcept;
+    mappedFile& operator=(mappedFile&& other) noexcept;
+
+    // Writable mode creates the file if it is missing. An empty file opens fine with data() == nullptr.
+    bool open(const std::string& path, bool writable);
+    void close();
+
+    // Grows or shrinks the file and remaps it. Pointers into the old mapping are invalidated.
+    bool resize(uint64_t newSize);
+
+    // Writes dirty pages back to disk
+    bool flush();
+
+    [[nodiscard]] uint8_t* data() const { return view; }
+    [[nodiscard]] uint64_t size() const { return length; }
+    [[nodiscard]] bool isOpen() const { return opened; }
+
+private:
+    uint8_t* view{nullptr};
+    uint64_t length{0};
+    bool writable{false};
+    bool opened{false};
+
+#if defined(_WIN32)
+    void* fileHandle{nullptr};
+    void* mappingHandle{nullptr};
+#else
+    int fd{-1};
+#endif
+
+    bool map();
+    void unmap();
+};
+
+// Exclusive advisory lock on a file (created if missing), held until
+// unlock() or destruction. flock / LockFileEx, so the OS drops it if the
+// process dies.
+class fileLock {
+public:
+    fileLock() = default;
+    ~fileLock();
+
+    fileLock(const fileLock&) = delete;
+    fileLock& operator=(const fileLock&) = delete;
+
+    // False straight away when another process holds it
+    bool tryLock(const std::string& path);
+    void unlock();
+
+    [[nodiscard]] bool isLocked() const { return locked; }
+
+private:
+    bool locked{false};
+
+#if defined(_WIN32)
+    void* fileHandle{nullptr};
+#else
+    int fd{-1};
+#endif
+};
+
+// fflush plus fsync / _commit, so an append survives a crash once this returns true.
+bool syncFile(std::FILE* file);
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,271 @@
+#include "saxExtractor.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace {
+
+// Only the handful of keys the extractor cares about
+enum class field {
+    Other,
+    Word,
+    Phonetic,
+    Phonetics,
+    Meanings,
+    Text,
+    PartOfSpeech,
+    Definitions,
+    Definition
+};
+
+field classify(const std::string &key) {
+    switch (key.size()) {
+        case 4:
+            if (key == "word") return field::Word;
+            if (key == "text") return field::Text;
+            break;
+        case 8:
+            if (key == "phonetic") return field::Phonetic;
+            if (key == "meanings") return field::Meanings;
+            break;
+        case 9:
+            if (key == "phonetics") return field::Phonetics;
+            break;
+        case 10:
+            if (key == "definition") return field::Definition;
+            break;
+        case 11:
+            if (key == "definitions") return field::Definitions;
+            break;
+        case 12:
+            if (key == "partOfSpeech") return field::PartOfSpeech;
+            break;
+        default:
+            break;
+    }
+    return field::Other;
+}
+
+// Path through the document, from the top-level array down:
+//   [responses] {entry} [phonetics] {phonetic}
+//   [responses] {entry} [meanings] {meaning} [definitions] {definition}
+struct level {
+    bool isObject;
+    field key{field::Other}; // last key seen, objects only
+    size_t index{0};         // element being parsed, arrays only
+    size_t elements{0};      // elements seen, arrays only
+};
+
+class extractor : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit extractor(WordData &out) : data(out) {}
+
+    bool null() override { return scalar(); }
+    bool boolean(bool) override { return scalar(); }
+    bool number_integer(number_integer_t) override { return scalar(); }
+    bool number_unsigned(number_unsigned_t) override { return scalar(); }
+    bool number_float(number_float_t, const string_t &) override { return scalar(); }
+    bool binary(binary_t &) override { return scalar(); }
+
+    bool string(string_t &value) override {
+        if (inEntry()) {
+            if (stack[1].key == field::Word) word = std::move(value);
+            else if (stack[1].key == field::Phonetic) phonetic = std::move(value);
+        }
+        else if (inPhonetic() && stack[3].key == field::Text) {
+            pendingText = std::move(value);
+        }
+        else if (inMeaning() && stack[3].key == field::PartOfSpeech) {
+            pendingPos = std::move(value);
+        }
+        else if (inDefinition() && stack[5].key == field::Definition) {
+            pendingDefinition = std::move(value);
+        }
+        return scalar();
+    }
+
+    bool start_object(std::size_t) override {
+        beginElement();
+        if (stack.size() == 1 && !stack[0].isObject && stack[0].index == 0) entryIsObject = true;
+        stack.push_back(level{true});
+        return true;
+    }
+
+    bool key(string_t &name) override {
+        field key = classify(name);
+        stack.back().key = key;
+
+        // A repeated key replaces the earlier value, as it does in the DOM
+        if (inEntry()) {
+            if (key == field::Word) word.reset();
+            else if (key == field::Phonetic) phonetic.reset();
+            else if (key == field::Phonetics) phoneticText.reset();
+            else if (key == field::Meanings) resetMeanings();
+        }
+        else if (inPhonetic() && key == field::Text) {
+            pendingText.reset();
+        }
+        else if (inMeaning() && key == field::PartOfSpeech) {
+            pendingPos.reset();
+        }
+        else if (inMeaning() && key == field::Definitions) {
+            meaningDefinitions.clear();
+        }
+        else if (inDefinition() && key == field::Definition) {
+            pendingDefinition.reset();
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (inPhonetic() && pendingText) {
+            // First non-empty text wins, empty ones only fill in until then
+            if (!phoneticText || phoneticText->empty()) phoneticText = std::move(pendingText);
+            pendingText.reset();
+        }
+        else if (inMeaning()) {
+            if (pendingPos) posList.push_back("_" + *pendingPos);
+            pendingPos.reset();
+
+            for (auto &definition : meaningDefinitions) definitions.push_back(std::move(definition));
+            meaningDefinitions.clear();
+        }
+        else if (inDefinition() && pendingDefinition) {
+            meaningDefinitions.push_back(std::move(*pendingDefinition));
+            pendingDefinition.reset();
+        }
+
+        stack.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        bool meaningsArray = inEntry() && stack[1].key == field::Meanings;
+        beginElement();
+        stack.push_back(level{false});
+        if (meaningsArray) meaningsIsArray = true;
+        return true;
+    }
+
+    bool end_array() override {
+        stack.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &ex) override {
+        errorMessage = ex.what();
+        return false;
+    }
+
+    // Applies the same rules as parseWordEntry() once the whole document has been read
+    void finish() {
+        if (!sawEntry) return;
+
+        if (word) data.word = *word;
+
+        if (phonetic) {
+            data.phonetic = *phonetic;
+        }
+        else if (phoneticText) {
+            data.phonetic = *phoneticText;
+        }
+
+        if (data.phonetic.empty())
+            data.phonetic = "-";
+
+        if (meaningsIsArray) {
+            data.definitionList = std::move(definitions);
+            std::sort(posList.begin(), posList.end());
+            posList.erase(std::unique(posList.begin(), posList.end()), posList.end());
+            data.posList = std::move(posList);
+        }
+    }
+
+    // The DOM parser's test for a usable answer: the first element is an object
+    [[nodiscard]] bool hasEntry() const { return entryIsObject; }
+
+    std::string errorMessage;
+
+private:
+    WordData &data;
+    std::vector<level> stack;
+
+    // Fields of the first entry
+    bool sawEntry{false};
+    bool entryIsObject{false};
+    std::optional<std::string> word;
+    std::optional<std::string> phonetic;
+    std::optional<std::string> phoneticText;
+    bool meaningsIsArray{false};
+    std::vector<std::string> posList; // sorted and deduplicated in finish()
+    std::vector<std::string> definitions;
+
+    // Values of the object currently open, committed when it closes
+    std::optional<std::string> pendingText;
+    std::optional<std::string> pendingPos;
+    std::optional<std::string> pendingDefinition;
+    std::vector<std::string> meaningDefinitions;
+
+    // Only the first element of the top-level array is the entry
+    [[nodiscard]] bool inEntry() const {
+        return stack.size() == 2 && !stack[0].isObject && stack[0].index == 0 && stack[1].isObject;
+    }
+
+    [[nodiscard]] bool inEntryChild(field key) const {
+        return stack.size() >= 4 && !stack[0].isObject && stack[0].index == 0 && stack[1].isObject &&
+               stack[1].key == key && stack[3].isObject;
+    }
+
+    // The DOM path iterates "phonetics" without checking its type, so an object's values count too
+    [[nodiscard]] bool inPhonetic() const {
+        return stack.size() == 4 && inEntryChild(field::Phonetics);
+    }
+
+    [[nodiscard]] bool inMeaning() const {
+        return stack.size() == 4 && inEntryChild(field::Meanings) && !stack[2].isObject;
+    }
+
+    [[nodiscard]] bool inDefinition() const {
+        return stack.size() == 6 && inEntryChild(field::Meanings) && !stack[2].isObject &&
+               stack[3].key == field::Definitions && !stack[4].isObject && stack[5].isObject;
+    }
+
+    void beginElement() {
+        if (!stack.empty() && !stack.back().isObject) {
+            stack.back().index = stack.back().elements++;
+            // Whatever the first element is, the DOM path hands it to parseWordEntry()
+            if (stack.size() == 1) sawEntry = true;
+        }
+    }
+
+    bool scalar() {
+        beginElement();
+        return true;
+    }
+
+    void resetMeanings() {
+        meaningsIsArray = false;
+        posList.clear();
+        definitions.clear();
+    }
+};
+
+} // namespace
+
+bool parseWordDataSax(const std::string &body, WordData &data) {
+    data = WordData{};
+
+    // Set default values for error cases
+    data.word = "Not Found";
+    data.phonetic = "/not_found/";
+
+    extractor handler(data);
+    if (!nlohmann::json::sax_parse(body, &handler)) {
+        std::cerr << "JSON parse error: " << handler.errorMessage << std::endl;
+        data.definitionList.push_back("Failed to parse the response from the API.");
+        return false;
+    }
+
+    handler.finish();
+    return handler.hasEntry();
+}
@@ -0,0 +1,14 @@
+#ifndef SAX_EXTRACTOR_H
+#define SAX_EXTRACTOR_H
+
+#include <string>
+
+#include "fetcher.h"
+
+// Streams an API response through nlohmann's SAX interface and keeps only
+// word, phonetic(s), partOfSpeech and definition of the first entry. No DOM
+// is built; the result matches the DOM parser field for field, including the
+// "Not Found" placeholders, the "-" phonetic fallback and the return value.
+bool parseWordDataSax(const std::string &body, WordData &data);
+
+#endif // SAX_EXTRACTOR_H
@@ -0,0 +1,80 @@
+#ifndef SINGLE_FLIGHT_H
+#define SINGLE_FLIGHT_H
+
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+struct singleFlightStats {
+    uint64_t started{0};   // calls that ran the work themselves
+    uint64_t coalesced{0}; // calls that waited for someone else's run of the same key
+    size_t inFlight{0};    // keys being worked on right now
+};
+
+// Collapses concurrent calls for the same key into one: the first caller runs
+// the work, everyone who asks for that key before it finishes waits for and
+// gets a copy of the same result (or the same exception). Nothing is kept
+// once the work is done; remembering results is the caches' job.
+//
+// Safe to call from any number of threads.
+template <typename T>
+class singleFlight {
+public:
+    template <typename Work>
+    T run(const std::string& key, Work&& work) {
+        std::promise<T> promise;
+        std::shared_future<T> result;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = pending.find(key);
+            if (it != pending.end()) {
+                counters.coalesced++;
+                result = it->second;
+            }
+            else {
+                counters.started++;
+                leader = true;
+                result = promise.get_future().share();
+                pending.emplace(key, result);
+            }
+        }
+        if (!leader) return result.get();
+
+        // Off the map before the result is published, so a caller arriving
+        // afterwards starts fresh (and normally finds it in a cache) instead
+        // of attaching to a finished flight
+        auto finish = [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.erase(key);
+        };
+        try {
+            T value = work();
+            finish();
+            promise.set_value(value);
+            return value;
+        }
+        catch (...) {
+            finish();
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    [[nodiscard]] singleFlightStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        singleFlightStats result = counters;
+        result.inFlight = pending.size();
+        return result;
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_future<T>> pending;
+    mutable std::mutex mutex;
+    singleFlightStats counters;
+};
+
+#endif // SINGLE_FLIGHT_H
@@ -0,0 +1,96 @@
+#include "wordCache.h"
+
+wordCache::wordCache(size_t maxEntries, size_t maxBytes)
+    : maxEntries(maxEntries), maxBytes(maxBytes) {}
+
+wordCache& wordCache::instance() {
+    static wordCache cache;
+    return cache;
+}
+
+size_t wordCache::estimateBytes(const std::string& key, const compactWordData& data) {
+    // key is stored in the list and the index
+    return sizeof(entry) + key.capacity() * 2 + data.bytes();
+}
+
+std::optional<WordData> wordCache::get(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+    if (it == index.end()) {
+        counters.misses++;
+        return std::nullopt;
+    }
+
+    counters.hits++;
+    lru.splice(lru.begin(), lru, it->second);
+    return it->second->data.toWordData();
+}
+
+void wordCache::put(const std::string& key, const WordData& data) {
+    compactWordData packed(data);
+    size_t bytes = estimateBytes(key, packed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = index.find(key);
+
+    // An entry bigger than the whole budget would only evict everything else.
+    // Whatever was cached under the key is stale now, so it goes either way.
+    if (bytes > maxBytes || maxEntries == 0) {
+        if (it != index.end()) {
+            currentBytes -= it->second->bytes;
+            lru.erase(it->second);
+            index.erase(it);
+        }
+        return;
+    }
+
+    if (it != index.end()) {
+        currentBytes -= it->second->bytes;
+        it->second->data = std::move(packed);
+        it->second->bytes = bytes;
+        currentBytes += bytes;
+        lru.splice(lru.begin(), lru, it->second);
+    }
+    else {
+        lru.push_front(entry{key, std::move(packed), bytes});
+        index.emplace(key, lru.begin());
+        currentBytes += bytes;
+        counters.insertions++;
+    }
+
+    evictOverBudget();
+}
+
+void wordCache::setLimits(size_t newMaxEntries, size_t newMaxBytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    maxEntries = newMaxEntries;
+    maxBytes = newMaxBytes;
+    evictOverBudget();
+}
+
+void wordCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    index.clear();
+    currentBytes = 0;
+}
+
+wordCacheStats wordCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    wordCacheStats result = counters;
+    result.entries = index.size();
+    result.bytes = currentBytes;
+    return result;
+}
+
+void wordCache::evictOverBudget() {
+    while (!lru.empty() && (index.size() > maxEntries || currentBytes > maxBytes)) {
+        const entry& victim = lru.back();
+        currentBytes -= victim.bytes;
+        index.erase(victim.key);
+        lru.pop_back();
+        counters.evictions++;
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef WORD_CACHE_H
+#define WORD_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "compactWordData.h"
+#include "fetcher.h"
+
+struct wordCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t insertions{0};
+    uint64_t evictions{0};
+    size_t entries{0};
+    size_t bytes{0};
+};
+
+// Bounded LRU cache of parsed WordData, keyed by normalizeWord(query).
+// Entries are held as compactWordData, one allocation each, and expanded on get().
+// Safe to use from the lookup worker threads and the render thread at once.
+class wordCache {
+public:
+    static constexpr size_t DEFAULT_MAX_ENTRIES = 512;
+    static constexpr size_t DEFAULT_MAX_BYTES = 8 * 1024 * 1024;
+
+    explicit wordCache(size_t maxEntries = DEFAULT_MAX_ENTRIES, size_t maxBytes = DEFAULT_MAX_BYTES);
+
+    // Key must already be normalized
+    std::optional<WordData> get(const std::string& key);
+    // A value too big for the byte budget is not kept, and drops whatever
+    // was cached under the key before
+    void put(const std::string& key, const WordData& data);
+
+    // Shrinking the limits evicts immediately
+    void setLimits(size_t maxEntries, size_t maxBytes);
+    void clear();
+
+    [[nodiscard]] wordCacheStats stats() const;
+
+    // Cache sitting in front of fetchWordData
+    static wordCache& instance();
+
+    // Approximate heap footprint of one entry, used for the byte budget
+    static size_t estimateBytes(const std::string& key, const compactWordData& data);
+
+private:
+    struct entry {
+        std::string key;
+        compactWordData data;
+        size_t bytes;
+    };
+
+    std::list<entry> lru; // front = most recently used
+    std::unordered_map<std::string, std::list<entry>::iterator> index;
+
+    size_t maxEntries;
+    size_t maxBytes;
+    size_t currentBytes{0};
+
+    mutable std::mutex mutex;
+    wordCacheStats counters;
+
+    void evictOverBudget();
+};
+
+#endif // WORD_CACHE_H
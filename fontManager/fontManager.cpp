@@ -0,0 +1,222 @@
+#include "fontManager.h"
+#include "textMeasure.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <tuple>
+
+// ============================================================================
+// fontHandle
+// ============================================================================
+
+fontHandle::fontHandle(entry* e) : slot(e) {
+    if (slot) fontManager::instance().retain(slot);
+}
+
+fontHandle::fontHandle(const fontHandle& other) : fontHandle(other.slot) {}
+
+fontHandle::fontHandle(fontHandle&& other) noexcept : slot(other.slot) {
+    other.slot = nullptr;
+}
+
+fontHandle& fontHandle::operator=(const fontHandle& other) {
+    if (this != &other) {
+        fontHandle copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+fontHandle& fontHandle::operator=(fontHandle&& other) noexcept {
+    if (this != &other) {
+        reset();
+        slot = other.slot;
+        other.slot = nullptr;
+    }
+    return *this;
+}
+
+fontHandle::~fontHandle() {
+    reset();
+}
+
+bool fontHandle::ensureGlyphs(const std::string& text) {
+    if (!slot || !slot->loaded || !slot->atlas) return false;
+    PROFILE_SCOPE("fontHandle::ensureGlyphs");
+    if (slot->atlas->ensure(text) == 0) return false;
+
+    TextMeasure::forgetFont(slot->font);
+    slot->font = slot->atlas->font();
+    fontManager::measure(*slot);
+    return true;
+}
+
+void fontHandle::reset() {
+    if (slot) {
+        fontManager::instance().release(slot);
+        slot = nullptr;
+    }
+}
+
+const Font& fontHandle::get() const {
+    if (slot && slot->loaded) return slot->font;
+
+    static Font fallback{};
+    fallback = GetFontDefault();
+    return fallback;
+}
+
+// ============================================================================
+// fontManager
+// ============================================================================
+
+fontManager& fontManager::instance() {
+    static fontManager manager;
+    return manager;
+}
+
+bool fontManager::key::operator<(const key& other) const {
+    return std::tie(size, dynamic, path, glyphs) < std::tie(other.size, other.dynamic, other.path, other.glyphs);
+}
+
+fontHandle fontManager::acquire(const std::string& path, int size, std::vector<int> glyphs) {
+    std::sort(glyphs.begin(), glyphs.end());
+    glyphs.erase(std::unique(glyphs.begin(), glyphs.end()), glyphs.end());
+
+    auto [it, inserted] = fonts.try_emplace(key{path, size, std::move(glyphs), false});
+    fontHandle::entry& e = it->second;
+
+    if (e.loaded) {
+        counters.hits++;
+        return fontHandle(&e);
+    }
+
+    PROFILE_SCOPE("fontManager::load");
+
+    // LoadFontEx wants a mutable array even though it only reads it
+    std::vector<int> codepoints = it->first.glyphs;
+    e.font = LoadFontEx(path.c_str(), size, codepoints.empty() ? nullptr : codepoints.data(),
+                        static_cast<int>(codepoints.size()));
+    SetTextureFilter(e.font.texture, TEXTURE_FILTER_POINT);
+    e.loaded = true;
+    counters.loads++;
+
+    measure(e);
+    return fontHandle(&e);
+}
+
+fontHandle fontManager::acquireDynamic(const std::string& path, int size) {
+    auto [it, inserted] = fonts.try_emplace(key{path, size, {}, true});
+    fontHandle::entry& e = it->second;
+
+    if (e.loaded) {
+        counters.hits++;
+        return fontHandle(&e);
+    }
+
+    PROFILE_SCOPE("fontManager::loadDynamic");
+    e.atlas = std::make_unique<glyphAtlas>(path, size);
+    e.font = e.atlas->font();
+    e.loaded = true;
+    counters.loads++;
+
+    measure(e);
+    return fontHandle(&e);
+}
+
+void fontManager::measure(fontHandle::entry& e) {
+    e.textureBytes = 0;
+    e.glyphBytes = 0;
+
+    if (e.atlas) {
+        e.textureBytes = e.atlas->textureBytes();
+        e.glyphBytes = e.atlas->glyphBytes();
+        return;
+    }
+
+    // A missing file comes back as raylib's default font, which is not ours to account for
+    if (e.font.texture.id == GetFontDefault().texture.id) return;
+
+    e.textureBytes = static_cast<size_t>(
+        GetPixelDataSize(e.font.texture.width, e.font.texture.height, e.font.texture.format));
+
+    e.glyphBytes = static_cast<size_t>(e.font.glyphCount) * (sizeof(GlyphInfo) + sizeof(Rectangle));
+    for (int i = 0; i < e.font.glyphCount; ++i) {
+        const Image& image = e.font.glyphs[i].image;
+        e.glyphBytes += static_cast<size_t>(GetPixelDataSize(image.width, image.height, image.format));
+    }
+}
+
+void fontManager::unload(fontHandle::entry& e) {
+    if (!e.loaded) return;
+
+    TextMeasure::forgetFont(e.font);
+    if (e.atlas) e.atlas.reset();
+    else UnloadFont(e.font);
+
+    e.font = Font{};
+    e.loaded = false;
+    counters.unloads++;
+}
+
+fontHandle fontManager::acquireForText(const std::string& path, int size, const std::string& text) {
+    int count = 0;
+    int* codepoints = LoadCodepoints(text.c_str(), &count);
+    std::vector<int> glyphs(codepoints, codepoints + count);
+    UnloadCodepoints(codepoints);
+
+    return acquire(path, size, std::move(glyphs));
+}
+
+void fontManager::retain(fontHandle::entry* e) {
+    e->refs++;
+    e->lastUsed = ++useCounter;
+}
+
+void fontManager::release(fontHandle::entry* e) {
+    e->refs--;
+    if (e->refs == 0) {
+        trimIdle(MAX_IDLE_FONTS);
+    }
+}
+
+size_t fontManager::trimIdle(size_t keep) {
+    std::vector<std::map<key, fontHandle::entry>::iterator> idle;
+    for (auto it = fonts.begin(); it != fonts.end(); ++it) {
+        if (it->second.refs == 0) idle.push_back(it);
+    }
+    if (idle.size() <= keep) return 0;
+
+    std::sort(idle.begin(), idle.end(),
+              [](const auto& a, const auto& b) { return a->second.lastUsed < b->second.lastUsed; });
+
+    size_t freed = idle.size() - keep;
+    for (size_t i = 0; i < freed; ++i) {
+        unload(idle[i]->second);
+        fonts.erase(idle[i]);
+    }
+    return freed;
+}
+
+void fontManager::unloadAll() {
+    for (auto it = fonts.begin(); it != fonts.end();) {
+        fontHandle::entry& e = it->second;
+        unload(e);
+
+        // Entries still referenced stay until their last handle lets go
+        if (e.refs == 0) it = fonts.erase(it);
+        else ++it;
+    }
+}
+
+fontManagerStats fontManager::stats() const {
+    fontManagerStats result = counters;
+    for (const auto& [k, e] : fonts) {
+        if (!e.loaded) continue;
+        result.residentFonts++;
+        if (e.refs > 0) result.referencedFonts++;
+        result.textureBytes += e.textureBytes;
+        result.glyphBytes += e.glyphBytes;
+    }
+    return result;
+}
@@ -0,0 +1,122 @@
+#ifndef FONT_MANAGER_H
+#define FONT_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <raylib.h>
+#include "glyphAtlas.h"
+
+struct fontManagerStats {
+    size_t residentFonts{0};   // loaded, with or without users
+    size_t referencedFonts{0}; // held by at least one handle
+    size_t textureBytes{0};    // GPU atlas memory
+    size_t glyphBytes{0};      // CPU-side glyph images and tables
+    uint64_t loads{0};
+    uint64_t hits{0};
+    uint64_t unloads{0};
+};
+
+class fontManager;
+
+// Reference to a font owned by fontManager. Copies share the font; the last
+// handle to go away returns it to the manager's idle list.
+class fontHandle {
+public:
+    fontHandle() = default;
+    fontHandle(const fontHandle& other);
+    fontHandle(fontHandle&& other) noexcept;
+    fontHandle& operator=(const fontHandle& other);
+    fontHandle& operator=(fontHandle&& other) noexcept;
+    ~fontHandle();
+
+    [[nodiscard]] bool valid() const { return slot != nullptr; }
+
+    // raylib's default font for an empty handle
+    [[nodiscard]] const Font& get() const;
+    operator const Font&() const { return get(); }
+
+    void reset();
+
+    // Dynamic fonts only: adds glyphs for any codepoint of text the atlas lacks.
+    // Returns true when glyphs were added, after which Font copies taken
+    // earlier are stale and must be fetched again with get().
+    bool ensureGlyphs(const std::string& text);
+
+private:
+    friend class fontManager;
+    struct entry;
+
+    explicit fontHandle(entry* e);
+
+    entry* slot{nullptr};
+};
+
+struct fontHandle::entry {
+    Font font{};
+    std::unique_ptr<glyphAtlas> atlas; // set for dynamic fonts
+    bool loaded{false};
+    size_t textureBytes{0};
+    size_t glyphBytes{0};
+    int refs{0};
+    uint64_t lastUsed{0};
+};
+
+// Process-wide cache of loaded fonts, keyed by path, size and glyph set.
+// Each combination is rasterized and uploaded once and shared by every
+// screen holding a handle to it. Fonts nobody holds stay resident for a
+// while so that switching screens back and forth does not reload them.
+//
+// Render thread only: loading and unloading touch the GL context.
+class fontManager {
+public:
+    static constexpr size_t MAX_IDLE_FONTS = 8;
+
+    // An empty glyph set means raylib's default (ASCII 32..126). Order and
+    // duplicates in the set do not matter.
+    fontHandle acquire(const std::string& path, int size, std::vector<int> glyphs = {});
+
+    // Glyph set taken from the codepoints of a UTF-8 string
+    fontHandle acquireForText(const std::string& path, int size, const std::string& text);
+
+    // Starts with ASCII and grows through fontHandle::ensureGlyphs(), for text
+    // whose codepoints are not known up front (phonetics, arbitrary UTF-8)
+    fontHandle acquireDynamic(const std::string& path, int size);
+
+    // Unloads fonts without a handle, least recently used first, until at most
+    // keep of them are left. Returns how many were freed.
+    size_t trimIdle(size_t keep = 0);
+
+    // Unloads everything. Call before CloseWindow(); handles still alive fall back to the default font.
+    void unloadAll();
+
+    [[nodiscard]] fontManagerStats stats() const;
+
+    static fontManager& instance();
+
+private:
+    friend class fontHandle;
+
+    struct key {
+        std::string path;
+        int size;
+        std::vector<int> glyphs; // sorted, unique
+        bool dynamic;
+
+        bool operator<(const key& other) const;
+    };
+
+    std::map<key, fontHandle::entry> fonts;
+    uint64_t useCounter{0};
+    fontManagerStats counters;
+
+    void retain(fontHandle::entry* e);
+    void release(fontHandle::entry* e);
+    void unload(fontHandle::entry& e);
+    static void measure(fontHandle::entry& e);
+};
+
+#endif // FONT_MANAGER_H
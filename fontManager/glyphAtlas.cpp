@@ -0,0 +1,146 @@
+#include "glyphAtlas.h"
+
+#include <algorithm>
+
+glyphAtlas::glyphAtlas(const std::string& path, int fontSize) : fontSize(fontSize) {
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(path.c_str(), &dataSize);
+    if (data == nullptr) return;
+
+    fileData.assign(data, data + dataSize);
+    UnloadFileData(data);
+
+    // Wide enough for a few dozen glyphs per shelf; height grows as needed
+    width = 256;
+    while (width < fontSize * 10 && width < 2048) width *= 2;
+
+    std::vector<int> ascii;
+    for (int c = 32; c < 127; ++c) ascii.push_back(c);
+    ensureCodepoints(ascii.data(), ascii.size());
+}
+
+glyphAtlas::~glyphAtlas() {
+    if (texture.id != 0) UnloadTexture(texture);
+}
+
+const Font& glyphAtlas::font() const {
+    if (isValid()) return current;
+
+    static Font fallback{};
+    fallback = GetFontDefault();
+    return fallback;
+}
+
+size_t glyphAtlas::ensure(const std::string& text) {
+    int count = 0;
+    int* codepoints = LoadCodepoints(text.c_str(), &count);
+    size_t added = ensureCodepoints(codepoints, static_cast<size_t>(count));
+    UnloadCodepoints(codepoints);
+    return added;
+}
+
+size_t glyphAtlas::ensureCodepoints(const int* codepoints, size_t count) {
+    if (!isValid()) return 0;
+
+    std::vector<int> missing;
+    for (size_t i = 0; i < count; ++i) {
+        if (!contains(codepoints[i])) missing.push_back(codepoints[i]);
+    }
+    std::sort(missing.begin(), missing.end());
+    missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+    if (missing.empty()) return 0;
+
+    // Rasterizes only the new codepoints
+    GlyphInfo* loaded = LoadFontData(fileData.data(), static_cast<int>(fileData.size()), fontSize, missing.data(),
+                                     static_cast<int>(missing.size()), FONT_DEFAULT);
+    if (loaded == nullptr) return 0;
+
+    int oldHeight = height;
+    int dirtyTop = height;
+    int dirtyBottom = 0;
+    size_t added = 0;
+
+    for (size_t i = 0; i < missing.size(); ++i) {
+        const Image& image = loaded[i].image;
+
+        int x = 0;
+        int y = 0;
+        if (!place(image.width + 2 * PADDING, image.height + 2 * PADDING, x, y)) continue;
+
+        // Same pixel layout raylib uses for its own font atlases: white, coverage in alpha
+        const auto* src = static_cast<const unsigned char*>(image.data);
+        for (int row = 0; row < image.height; ++row) {
+            unsigned char* dst = pixels.data() + (static_cast<size_t>(y + PADDING + row) * width + x + PADDING) * BYTES_PER_PIXEL;
+            for (int col = 0; col < image.width; ++col) {
+                dst[col * BYTES_PER_PIXEL] = 255;
+                dst[col * BYTES_PER_PIXEL + 1] = src ? src[row * image.width + col] : 0;
+            }
+        }
+
+        GlyphInfo glyph = loaded[i];
+        glyph.image = Image{}; // pixels live in the atlas now
+
+        indexOf[glyph.value] = static_cast<int>(glyphs.size());
+        glyphs.push_back(glyph);
+        recs.push_back(Rectangle{static_cast<float>(x + PADDING), static_cast<float>(y + PADDING),
+                                 static_cast<float>(image.width), static_cast<float>(image.height)});
+
+        dirtyTop = std::min(dirtyTop, y);
+        dirtyBottom = std::max(dirtyBottom, y + image.height + 2 * PADDING);
+        added++;
+    }
+
+    UnloadFontData(loaded, static_cast<int>(missing.size()));
+
+    if (added > 0) upload(dirtyTop, dirtyBottom, height != oldHeight);
+    return added;
+}
+
+bool glyphAtlas::place(int glyphWidth, int glyphHeight, int& x, int& y) {
+    if (glyphWidth > width) return false;
+
+    if (penX + glyphWidth > width) {
+        penY += shelfHeight;
+        penX = 0;
+        shelfHeight = 0;
+    }
+
+    if (penY + glyphHeight > height) {
+        int newHeight = std::max(height * 2, 64);
+        while (newHeight < penY + glyphHeight) newHeight *= 2;
+        if (newHeight > MAX_HEIGHT) return false;
+
+        // Existing rows keep their offsets, new rows start fully transparent
+        pixels.resize(static_cast<size_t>(width) * newHeight * BYTES_PER_PIXEL, 0);
+        height = newHeight;
+    }
+
+    x = penX;
+    y = penY;
+    penX += glyphWidth;
+    shelfHeight = std::max(shelfHeight, glyphHeight);
+    return true;
+}
+
+void glyphAtlas::upload(int dirtyTop, int dirtyBottom, bool resized) {
+    if (texture.id == 0 || resized) {
+        if (texture.id != 0) UnloadTexture(texture);
+
+        Image image{pixels.data(), width, height, 1, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA};
+        texture = LoadTextureFromImage(image);
+        SetTextureFilter(texture, TEXTURE_FILTER_POINT);
+    }
+    else {
+        // Rows are contiguous, so the touched shelves are one sub-image
+        Rectangle band{0, static_cast<float>(dirtyTop), static_cast<float>(width),
+                       static_cast<float>(dirtyBottom - dirtyTop)};
+        UpdateTextureRec(texture, band, pixels.data() + static_cast<size_t>(dirtyTop) * width * BYTES_PER_PIXEL);
+    }
+
+    current.baseSize = fontSize;
+    current.glyphCount = static_cast<int>(glyphs.size());
+    current.glyphPadding = PADDING;
+    current.texture = texture;
+    current.recs = recs.data();
+    current.glyphs = glyphs.data();
+}
@@ -0,0 +1,71 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <raylib.h>
+
+// A font whose atlas grows on demand. It starts with printable ASCII and
+// rasterizes any other codepoint the first time it is asked for, packing it
+// into the free space of the existing texture. Glyphs already in the atlas
+// are never rasterized again; when the texture runs out of rows it is made
+// taller, the existing pixels are copied over and the whole thing is uploaded
+// once.
+//
+// font() is an ordinary raylib Font, so DrawTextEx and MeasureTextEx work
+// unchanged. Adding glyphs may move the glyph arrays and replace the texture,
+// so Font copies taken before an ensure() call that returned non-zero are stale.
+class glyphAtlas {
+public:
+    glyphAtlas(const std::string& path, int fontSize);
+    ~glyphAtlas();
+
+    glyphAtlas(const glyphAtlas&) = delete;
+    glyphAtlas& operator=(const glyphAtlas&) = delete;
+
+    // False when the font file could not be read; font() is then raylib's default
+    [[nodiscard]] bool isValid() const { return !fileData.empty(); }
+
+    // Makes sure every codepoint of the UTF-8 text has a glyph. Returns how many were added.
+    size_t ensure(const std::string& text);
+    size_t ensureCodepoints(const int* codepoints, size_t count);
+
+    [[nodiscard]] bool contains(int codepoint) const { return indexOf.count(codepoint) != 0; }
+    [[nodiscard]] const Font& font() const;
+
+    [[nodiscard]] size_t glyphCount() const { return glyphs.size(); }
+    [[nodiscard]] size_t textureBytes() const { return pixels.size(); }
+    [[nodiscard]] size_t glyphBytes() const { return glyphs.capacity() * (sizeof(GlyphInfo) + sizeof(Rectangle)); }
+
+private:
+    static constexpr int PADDING = 4;        // same as raylib's own atlases
+    static constexpr int BYTES_PER_PIXEL = 2; // PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA
+    static constexpr int MAX_HEIGHT = 8192;
+
+    std::vector<unsigned char> fileData;
+    int fontSize;
+
+    std::vector<GlyphInfo> glyphs;
+    std::vector<Rectangle> recs;
+    std::unordered_map<int, int> indexOf;
+
+    // CPU copy of the atlas; rows are contiguous so growing only appends
+    std::vector<unsigned char> pixels;
+    int width{0};
+    int height{0};
+
+    // Shelf packer state
+    int penX{0};
+    int penY{0};
+    int shelfHeight{0};
+
+    Texture2D texture{};
+    Font current{};
+
+    bool place(int glyphWidth, int glyphHeight, int& x, int& y);
+    void upload(int dirtyTop, int dirtyBottom, bool resized);
+};
+
+#endif // GLYPH_ATLAS_H
@@ -0,0 +1,128 @@
+#include "headwords.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "fetcher.h"
+#include "lexicon.h"
+
+namespace {
+
+std::string headwordListPath = "headwords.txt";
+
+} // namespace
+
+headwordIndex::~headwordIndex() {
+    if (loader.joinable()) loader.join();
+}
+
+void headwordIndex::configure(const std::string& path) {
+    headwordListPath = path;
+}
+
+headwordIndex& headwordIndex::instance() {
+    static headwordIndex index;
+    return index;
+}
+
+void headwordIndex::startLoading(std::function<void()> onPublished) {
+    std::call_once(started, [this, &onPublished]() {
+        published = std::move(onPublished);
+        loading.store(true);
+        loader = std::thread([this]() { load(); });
+    });
+}
+
+std::shared_ptr<const prefixIndex> headwordIndex::prefixes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return prefixIdx;
+}
+
+std::shared_ptr<const spellIndex> headwordIndex::spelling() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return spellIdx;
+}
+
+bool headwordIndex::isKnownMisspelling(const std::string& normalizedWord,
+                                       std::vector<spellIndex::correction>* corrections) const {
+    if (!isComplete()) return false;
+
+    std::shared_ptr<const spellIndex> spell = spelling();
+    if (!spell || spell->size() == 0) return false;
+
+    auto found = spell->lookup(normalizedWord);
+    if (!found.empty() && found.front().distance == 0) return false;
+
+    if (corrections) *corrections = found;
+    return !found.empty();
+}
+
+void headwordIndex::load() {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<prefixIndex::headword> words;
+
+    const lexicon& offline = lexicon::instance();
+    words.reserve(offline.size());
+    for (size_t i = 0; i < offline.size(); ++i) {
+        words.push_back({std::string(offline.keyAt(i)), 0});
+    }
+
+    std::ifstream list(headwordListPath);
+    std::string line;
+    bool firstLine = true;
+    bool listIsComplete = false;
+    while (std::getline(list, line)) {
+        if (firstLine) {
+            firstLine = false;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line == "#complete") {
+                listIsComplete = true;
+                continue;
+            }
+        }
+
+        uint32_t frequency = 0;
+        size_t tab = line.find('\t');
+        if (tab != std::string::npos) {
+            try {
+                frequency = static_cast<uint32_t>(std::stoul(line.substr(tab + 1)));
+            }
+            catch (const std::exception&) {
+                frequency = 0;
+            }
+            line.resize(tab);
+        }
+
+        std::string word = normalizeWord(line);
+        if (!word.empty()) words.push_back({std::move(word), frequency});
+    }
+
+    auto index = std::make_shared<prefixIndex>();
+    index->build(std::move(words));
+
+    // Autocomplete is usable as soon as the trie is done
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        prefixIdx = index;
+    }
+    if (published) published();
+
+    auto spell = std::make_shared<spellIndex>();
+    spell->build(index->headwords());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        spellIdx = spell;
+    }
+    complete.store(listIsComplete);
+    ready.store(true);
+    if (published) published();
+    loading.store(false);
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Headword index: " << index->size() << " words, "
+              << (index->memoryBytes() + spell->memoryBytes()) / 1024 << " KiB, built in " << ms << " ms"
+              << (listIsComplete ? ", complete" : "") << "\n";
+}
@@ -0,0 +1,75 @@
+#ifndef HEADWORDS_H
+#define HEADWORDS_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "prefixIndex.h"
+#include "spellIndex.h"
+
+// Owns the indexes built over the known headword set. They are built on a
+// background thread at startup and published once complete, so callers on
+// the render thread get either nothing yet or a finished, immutable index.
+//
+// Headwords come from the offline lexicon and from a plain text list
+// (one word per line, optionally followed by a tab and a frequency).
+// Neither is assumed to be a whole dictionary: only a list whose first line
+// is "#complete" claims to hold every word there is.
+class headwordIndex {
+public:
+    headwordIndex() = default;
+    ~headwordIndex();
+
+    headwordIndex(const headwordIndex&) = delete;
+    headwordIndex& operator=(const headwordIndex&) = delete;
+
+    // Starts the background build. Calling it again does nothing.
+    // onPublished runs on the loader thread each time an index becomes
+    // available (prefixes first, then spelling), e.g. to wake the UI.
+    void startLoading(std::function<void()> onPublished = {});
+
+    [[nodiscard]] bool isReady() const { return ready.load(); }
+
+    // Started and not yet past its last onPublished call
+    [[nodiscard]] bool isLoading() const { return loading.load(); }
+
+    // The headword list was marked complete, so a word missing from it does not exist
+    [[nodiscard]] bool isComplete() const { return complete.load(); }
+
+    // Null until the build has finished
+    [[nodiscard]] std::shared_ptr<const prefixIndex> prefixes() const;
+    [[nodiscard]] std::shared_ptr<const spellIndex> spelling() const;
+
+    // True when the index is built from a complete list, non-empty and does
+    // not know the word, but has a close correction for it. Such a word is
+    // not worth a network round trip. Always false for an incomplete list,
+    // where a missing word ("cats" when only "cat" is listed) may still exist.
+    [[nodiscard]] bool isKnownMisspelling(const std::string& normalizedWord,
+                                          std::vector<spellIndex::correction>* corrections = nullptr) const;
+
+    // Where the plain headword list lives. Only has an effect before startLoading().
+    static void configure(const std::string& headwordListPath);
+
+    static headwordIndex& instance();
+
+private:
+    std::thread loader;
+    std::once_flag started;
+    std::atomic<bool> ready{false};
+    std::atomic<bool> loading{false};
+    std::atomic<bool> complete{false};
+    std::function<void()> published;
+
+    mutable std::mutex mutex;
+    std::shared_ptr<const prefixIndex> prefixIdx;
+    std::shared_ptr<const spellIndex> spellIdx;
+
+    void load();
+};
+
+#endif // HEADWORDS_H
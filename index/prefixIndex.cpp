@@ -0,0 +1,156 @@
+#include "prefixIndex.h"
+
+#include <algorithm>
+#include <numeric>
+#include <queue>
+
+void prefixIndex::build(std::vector<headword> input) {
+    nodes.clear();
+    words.clear();
+
+    std::sort(input.begin(), input.end(),
+        [](const headword& a, const headword& b) { return a.word < b.word; });
+
+    // Merge duplicates, keeping the highest frequency
+    std::vector<headword> unique;
+    unique.reserve(input.size());
+    for (auto& item : input) {
+        if (item.word.empty()) continue;
+        if (!unique.empty() && unique.back().word == item.word) {
+            unique.back().frequency = std::max(unique.back().frequency, item.frequency);
+        }
+        else {
+            unique.push_back(std::move(item));
+        }
+    }
+
+    // Rank order: frequency, then length, then alphabetical
+    std::vector<uint32_t> byRank(unique.size());
+    std::iota(byRank.begin(), byRank.end(), 0u);
+    std::sort(byRank.begin(), byRank.end(), [&unique](uint32_t a, uint32_t b) {
+        if (unique[a].frequency != unique[b].frequency) return unique[a].frequency > unique[b].frequency;
+        if (unique[a].word.size() != unique[b].word.size()) return unique[a].word.size() < unique[b].word.size();
+        return a < b;
+    });
+
+    // unique is alphabetical, so sorted[i] is the rank of the i-th word alphabetically
+    std::vector<uint32_t> sorted(unique.size());
+    words.resize(unique.size());
+    for (uint32_t rank = 0; rank < byRank.size(); ++rank) {
+        sorted[byRank[rank]] = rank;
+        words[rank] = std::move(unique[byRank[rank]].word);
+    }
+
+    nodes.push_back(node{0, NO_WORD, NO_WORD, 0, '\0'});
+    if (!sorted.empty()) {
+        buildRange(sorted, 0, sorted.size(), 0, 0);
+    }
+    nodes.shrink_to_fit();
+}
+
+uint32_t prefixIndex::buildRange(const std::vector<uint32_t>& sorted, size_t lo, size_t hi,
+                                 size_t depth, uint32_t nodeIndex) {
+    uint32_t best = NO_WORD;
+
+    // Alphabetical order puts the word that ends exactly here first
+    if (lo < hi && words[sorted[lo]].size() == depth) {
+        nodes[nodeIndex].word = sorted[lo];
+        best = sorted[lo];
+        lo++;
+    }
+
+    // Count the distinct next characters, their nodes are allocated as one block
+    uint16_t groups = 0;
+    for (size_t i = lo; i < hi; ++i) {
+        if (i == lo || words[sorted[i]][depth] != words[sorted[i - 1]][depth]) groups++;
+    }
+
+    auto firstChild = static_cast<uint32_t>(nodes.size());
+    nodes[nodeIndex].firstChild = firstChild;
+    nodes[nodeIndex].childCount = groups;
+    nodes.resize(nodes.size() + groups, node{0, NO_WORD, NO_WORD, 0, '\0'});
+
+    uint32_t child = firstChild;
+    for (size_t start = lo; start < hi; ++child) {
+        char label = words[sorted[start]][depth];
+        size_t end = start + 1;
+        while (end < hi && words[sorted[end]][depth] == label) end++;
+
+        nodes[child].label = label;
+        best = std::min(best, buildRange(sorted, start, end, depth + 1, child));
+        start = end;
+    }
+
+    nodes[nodeIndex].bestRank = best;
+    return best;
+}
+
+int64_t prefixIndex::findChild(uint32_t nodeIndex, char label) const {
+    const node& parent = nodes[nodeIndex];
+    auto begin = nodes.begin() + parent.firstChild;
+    auto end = begin + parent.childCount;
+
+    auto it = std::lower_bound(begin, end, label, [](const node& n, char c) {
+        return static_cast<unsigned char>(n.label) < static_cast<unsigned char>(c);
+    });
+    if (it == end || it->label != label) return -1;
+    return it - nodes.begin();
+}
+
+int64_t prefixIndex::walk(std::string_view prefix) const {
+    if (nodes.empty()) return -1;
+
+    int64_t current = 0;
+    for (char c : prefix) {
+        current = findChild(static_cast<uint32_t>(current), c);
+        if (current < 0) return -1;
+    }
+    return current;
+}
+
+std::vector<std::string> prefixIndex::complete(std::string_view prefix, size_t k) const {
+    std::vector<std::string> results;
+    int64_t start = walk(prefix);
+    if (start < 0 || k == 0 || nodes[start].bestRank == NO_WORD) return results;
+
+    struct candidate {
+        uint32_t rank;
+        uint32_t index;
+        bool isWord;
+        bool operator>(const candidate& other) const { return rank > other.rank; }
+    };
+
+    std::priority_queue<candidate, std::vector<candidate>, std::greater<>> frontier;
+    frontier.push({nodes[start].bestRank, static_cast<uint32_t>(start), false});
+
+    while (!frontier.empty() && results.size() < k) {
+        candidate top = frontier.top();
+        frontier.pop();
+
+        if (top.isWord) {
+            results.push_back(words[top.index]);
+            continue;
+        }
+
+        const node& current = nodes[top.index];
+        if (current.word != NO_WORD) {
+            frontier.push({current.word, current.word, true});
+        }
+        for (uint32_t c = current.firstChild; c < current.firstChild + current.childCount; ++c) {
+            frontier.push({nodes[c].bestRank, c, false});
+        }
+    }
+
+    return results;
+}
+
+bool prefixIndex::contains(std::string_view word) const {
+    int64_t found = walk(word);
+    return found >= 0 && nodes[found].word != NO_WORD;
+}
+
+size_t prefixIndex::memoryBytes() const {
+    size_t total = nodes.capacity() * sizeof(node) + words.capacity() * sizeof(std::string);
+    for (const auto& word : words) total += word.capacity() > 15 ? word.capacity() : 0;
+    return total;
+}
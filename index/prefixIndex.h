@@ -0,0 +1,57 @@
+#ifndef PREFIX_INDEX_H
+#define PREFIX_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Top-k prefix completion over a fixed headword list.
+//
+// The trie is stored as flat arrays: every node's children sit next to each
+// other, sorted by label, and each node remembers the best rank found in its
+// subtree. A query walks down the prefix and then expands nodes best-first,
+// so it touches roughly k * fanout nodes no matter how many words share the prefix.
+class prefixIndex {
+public:
+    struct headword {
+        std::string word;     // normalized form, see normalizeWord()
+        uint32_t frequency{0}; // higher ranks first; ties prefer shorter, then alphabetical
+    };
+
+    prefixIndex() = default;
+
+    // Duplicate words keep their highest frequency
+    void build(std::vector<headword> words);
+
+    // Best k completions of an already normalized prefix, best first
+    [[nodiscard]] std::vector<std::string> complete(std::string_view prefix, size_t k) const;
+
+    [[nodiscard]] bool contains(std::string_view word) const;
+    [[nodiscard]] size_t size() const { return words.size(); }
+    [[nodiscard]] size_t nodeCount() const { return nodes.size(); }
+    [[nodiscard]] size_t memoryBytes() const;
+
+    [[nodiscard]] const std::vector<std::string>& headwords() const { return words; }
+
+private:
+    static constexpr uint32_t NO_WORD = UINT32_MAX;
+
+    struct node {
+        uint32_t firstChild;
+        uint32_t bestRank; // lowest rank of any word in the subtree
+        uint32_t word;     // index into words (which is sorted by rank), or NO_WORD
+        uint16_t childCount;
+        char label;
+    };
+
+    std::vector<node> nodes;          // nodes[0] is the root
+    std::vector<std::string> words;   // sorted by rank, so a word's index is its rank
+
+    uint32_t buildRange(const std::vector<uint32_t>& sorted, size_t lo, size_t hi, size_t depth, uint32_t nodeIndex);
+    [[nodiscard]] int64_t findChild(uint32_t nodeIndex, char label) const;
+    [[nodiscard]] int64_t walk(std::string_view prefix) const;
+};
+
+#endif // PREFIX_INDEX_H
@@ -0,0 +1,134 @@
+#include "spellIndex.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+uint32_t spellIndex::hashDelete(std::string_view text) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void spellIndex::generateDeletes(std::string_view text, int maxDistance, std::vector<std::string>& out) {
+    out.clear();
+    out.emplace_back(text);
+
+    // Breadth-first over edit distance, each level removes one more byte
+    size_t levelStart = 0;
+    for (int level = 0; level < maxDistance; ++level) {
+        size_t levelEnd = out.size();
+        for (size_t i = levelStart; i < levelEnd; ++i) {
+            for (size_t pos = 0; pos < out[i].size(); ++pos) {
+                std::string shorter = out[i];
+                shorter.erase(pos, 1);
+                out.push_back(std::move(shorter));
+            }
+        }
+        levelStart = levelEnd;
+    }
+
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+void spellIndex::build(const std::vector<std::string>& rankedWords) {
+    words = rankedWords;
+    deletes.clear();
+
+    std::vector<std::string> variants;
+    for (uint32_t id = 0; id < words.size(); ++id) {
+        std::string_view prefix = std::string_view(words[id]).substr(0, PREFIX_LENGTH);
+        generateDeletes(prefix, MAX_DISTANCE, variants);
+
+        for (const auto& variant : variants) {
+            deletes.push_back((uint64_t{hashDelete(variant)} << 32) | id);
+        }
+    }
+
+    std::sort(deletes.begin(), deletes.end());
+    deletes.shrink_to_fit();
+}
+
+int spellIndex::distance(std::string_view a, std::string_view b, int maxDistance) {
+    if (a.size() > b.size()) std::swap(a, b);
+
+    int lengthGap = static_cast<int>(b.size() - a.size());
+    if (lengthGap > maxDistance) return maxDistance + 1;
+
+    // Three rolling rows are enough for transpositions
+    std::vector<int> previous2(a.size() + 1);
+    std::vector<int> previous(a.size() + 1);
+    std::vector<int> current(a.size() + 1);
+
+    for (size_t i = 0; i <= a.size(); ++i) previous[i] = static_cast<int>(i);
+
+    for (size_t j = 1; j <= b.size(); ++j) {
+        current[0] = static_cast<int>(j);
+        int rowBest = current[0];
+
+        for (size_t i = 1; i <= a.size(); ++i) {
+            int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            int value = std::min({previous[i] + 1, current[i - 1] + 1, previous[i - 1] + cost});
+
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1]) {
+                value = std::min(value, previous2[i - 2] + 1);
+            }
+
+            current[i] = value;
+            rowBest = std::min(rowBest, value);
+        }
+
+        if (rowBest > maxDistance) return maxDistance + 1;
+        std::swap(previous2, previous);
+        std::swap(previous, current);
+    }
+
+    return std::min(previous[a.size()], maxDistance + 1);
+}
+
+std::vector<spellIndex::correction> spellIndex::lookup(std::string_view word, int maxDistance, size_t k) const {
+    std::vector<correction> results;
+    if (word.empty() || words.empty()) return results;
+
+    maxDistance = std::clamp(maxDistance, 0, MAX_DISTANCE);
+
+    std::vector<std::string> variants;
+    generateDeletes(word.substr(0, PREFIX_LENGTH), maxDistance, variants);
+
+    std::unordered_set<uint32_t> checked;
+    std::vector<std::pair<int, uint32_t>> found; // (distance, id)
+
+    for (const auto& variant : variants) {
+        uint64_t low = uint64_t{hashDelete(variant)} << 32;
+        auto it = std::lower_bound(deletes.begin(), deletes.end(), low);
+
+        for (; it != deletes.end() && (*it >> 32) == (low >> 32); ++it) {
+            auto id = static_cast<uint32_t>(*it & 0xFFFFFFFFu);
+            if (!checked.insert(id).second) continue;
+
+            int d = distance(word, words[id], maxDistance);
+            if (d <= maxDistance) found.emplace_back(d, id);
+        }
+    }
+
+    // Nearest first, then by the ranking the words were built with
+    std::sort(found.begin(), found.end());
+    for (size_t i = 0; i < found.size() && results.size() < k; ++i) {
+        results.push_back({words[found[i].second], found[i].first});
+    }
+    return results;
+}
+
+bool spellIndex::contains(std::string_view word) const {
+    auto exact = lookup(word, 0, 1);
+    return !exact.empty();
+}
+
+size_t spellIndex::memoryBytes() const {
+    size_t total = deletes.capacity() * sizeof(uint64_t) + words.capacity() * sizeof(std::string);
+    for (const auto& word : words) total += word.capacity() > 15 ? word.capacity() : 0;
+    return total;
+}
@@ -0,0 +1,53 @@
+#ifndef SPELL_INDEX_H
+#define SPELL_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// "Did you mean" corrections over a fixed headword list, SymSpell style.
+//
+// Every headword contributes the deletes of its first PREFIX_LENGTH bytes
+// (up to MAX_DISTANCE of them). A query generates the same deletes for its
+// own prefix, looks them up, and verifies the few candidates with an
+// optimal-string-alignment distance. The delete table is a sorted array of
+// (hash, word id) pairs, so there is no per-entry allocation.
+class spellIndex {
+public:
+    static constexpr int MAX_DISTANCE = 2;
+    static constexpr size_t PREFIX_LENGTH = 7;
+
+    struct correction {
+        std::string word;
+        int distance;
+    };
+
+    spellIndex() = default;
+
+    // Words must be normalized and unique. Their order is the ranking used to
+    // break distance ties, e.g. prefixIndex::headwords().
+    void build(const std::vector<std::string>& rankedWords);
+
+    // Closest headwords within maxDistance, nearest first. Includes the word
+    // itself at distance 0 when it is a known headword.
+    [[nodiscard]] std::vector<correction> lookup(std::string_view word, int maxDistance = MAX_DISTANCE,
+                                                 size_t k = 5) const;
+
+    [[nodiscard]] bool contains(std::string_view word) const;
+    [[nodiscard]] size_t size() const { return words.size(); }
+    [[nodiscard]] size_t memoryBytes() const;
+
+    // Bounded optimal-string-alignment distance, returns maxDistance + 1 when exceeded
+    static int distance(std::string_view a, std::string_view b, int maxDistance);
+
+private:
+    std::vector<std::string> words;
+    std::vector<uint64_t> deletes; // (hash << 32) | word id, sorted
+
+    static uint32_t hashDelete(std::string_view text);
+    static void generateDeletes(std::string_view text, int maxDistance, std::vector<std::string>& out);
+};
+
+#endif // SPELL_INDEX_H
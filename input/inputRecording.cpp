@@ -0,0 +1,209 @@
+#include "inputRecording.h"
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+// ============================================================================
+// inputRecorder
+// ============================================================================
+
+bool inputRecorder::open(const std::string& path, const inputRecordingHeader& header) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    nlohmann::json line = {{"version", header.version}, {"width", header.width}, {"height", header.height}};
+    out << line.dump() << '\n';
+    frames = 0;
+    return static_cast<bool>(out);
+}
+
+void inputRecorder::write(const InputFrame& frame) {
+    if (!out.is_open()) return;
+
+    nlohmann::json line = {{"t", frame.time}, {"dt", frame.frameTime}};
+    if (!frame.chars.empty()) line["c"] = frame.chars;
+    if (!frame.keysPressed.empty()) line["k"] = frame.keysPressed;
+    line["m"] = {frame.mouse.x, frame.mouse.y};
+    if (frame.mouseDelta.x != 0.0f || frame.mouseDelta.y != 0.0f) line["md"] = {frame.mouseDelta.x, frame.mouseDelta.y};
+    if (frame.wheel != 0.0f) line["w"] = frame.wheel;
+    if (frame.buttonsPressed) line["bp"] = frame.buttonsPressed;
+    if (frame.buttonsDown) line["bd"] = frame.buttonsDown;
+    if (frame.buttonsReleased) line["br"] = frame.buttonsReleased;
+
+    out << line.dump() << '\n';
+    frames++;
+}
+
+void inputRecorder::close() {
+    if (out.is_open()) out.close();
+}
+
+// ============================================================================
+// inputPlayer
+// ============================================================================
+
+static Vector2 readVector(const nlohmann::json& line, const char* key) {
+    auto it = line.find(key);
+    if (it == line.end() || !it->is_array() || it->size() != 2) return {0, 0};
+    return {(*it)[0].get<float>(), (*it)[1].get<float>()};
+}
+
+bool inputPlayer::open(const std::string& path) {
+    frames.clear();
+    position = 0;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        lastError = "cannot open " + path;
+        return false;
+    }
+
+    std::string text;
+    size_t lineNumber = 0;
+    try {
+        while (std::getline(in, text)) {
+            lineNumber++;
+            if (text.empty()) continue;
+            nlohmann::json line = nlohmann::json::parse(text);
+
+            if (lineNumber == 1) {
+                info.version = line.value("version", 0);
+                info.width = line.value("width", 0);
+                info.height = line.value("height", 0);
+                if (info.version != 1) {
+                    lastError = path + " is not an input recording (version " + std::to_string(info.version) + ")";
+                    return false;
+                }
+                continue;
+            }
+
+            InputFrame frame;
+            frame.time = line.value("t", 0.0);
+            frame.frameTime = line.value("dt", 0.0f);
+            frame.chars = line.value("c", std::vector<int>{});
+            frame.keysPressed = line.value("k", std::vector<int>{});
+            frame.mouse = readVector(line, "m");
+            frame.mouseDelta = readVector(line, "md");
+            frame.wheel = line.value("w", 0.0f);
+            frame.buttonsPressed = line.value("bp", uint8_t{0});
+            frame.buttonsDown = line.value("bd", uint8_t{0});
+            frame.buttonsReleased = line.value("br", uint8_t{0});
+            frames.push_back(std::move(frame));
+        }
+    }
+    catch (const nlohmann::json::exception& e) {
+        lastError = path + ":" + std::to_string(lineNumber) + ": " + e.what();
+        frames.clear();
+        return false;
+    }
+
+    if (lineNumber == 0) {
+        lastError = path + " is empty";
+        return false;
+    }
+    return true;
+}
+
+bool inputPlayer::next(InputFrame& frame) {
+    if (position >= frames.size()) return false;
+    frame = frames[position++];
+    return true;
+}
+
+double inputPlayer::nextOffset() const {
+    if (position >= frames.size()) return 0.0;
+    return frames[position].time - frames.front().time;
+}
+
+// ============================================================================
+// frameTimeReport
+// ============================================================================
+
+void frameTimeReport::add(size_t frameIndex, double ms, bool drawn, const InputFrame& input) {
+    samples.push_back({frameIndex, ms, drawn, describe(input)});
+}
+
+std::string frameTimeReport::describe(const InputFrame& input) {
+    std::string text;
+    auto append = [&](const std::string& part) {
+        if (!text.empty()) text += ", ";
+        text += part;
+    };
+
+    if (!input.chars.empty()) {
+        std::string typed;
+        for (int c : input.chars) typed += c < 128 ? static_cast<char>(c) : '?';
+        append("'" + typed + "'");
+    }
+    for (int key : input.keysPressed) {
+        switch (key) {
+            case KEY_ENTER: append("Enter"); break;
+            case KEY_BACKSPACE: append("Backspace"); break;
+            case KEY_UP: append("Up"); break;
+            case KEY_DOWN: append("Down"); break;
+            case KEY_ESCAPE: append("Escape"); break;
+            default:
+                // Printable keys already show up as chars
+                if (key < 32 || key > 126) append("key " + std::to_string(key));
+        }
+    }
+    if (input.buttonsPressed) append("click");
+    if (input.wheel != 0.0f) append("wheel");
+    return text;
+}
+
+// Nearest rank, like DictionaryBatch's latency summary
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+bool frameTimeReport::write(const std::string& path) const {
+    std::vector<double> all;
+    std::vector<double> drawn;
+    for (const sample& s : samples) {
+        all.push_back(s.ms);
+        if (s.drawn) drawn.push_back(s.ms);
+    }
+    std::sort(all.begin(), all.end());
+    std::sort(drawn.begin(), drawn.end());
+
+    std::vector<sample> worst = samples;
+    std::sort(worst.begin(), worst.end(), [](const sample& a, const sample& b) { return a.ms > b.ms; });
+    if (worst.size() > WORST_FRAMES) worst.resize(WORST_FRAMES);
+
+    TraceLog(LOG_INFO, "REPLAY: %zu frames (%zu drawn), p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms",
+             all.size(), drawn.size(), percentile(all, 0.50), percentile(all, 0.95), percentile(all, 0.99),
+             percentile(all, 1.0));
+    for (const sample& s : worst) {
+        TraceLog(LOG_INFO, "REPLAY:   frame %zu %.2f ms%s%s%s", s.frame, s.ms, s.drawn ? "" : " (not drawn)",
+                 s.input.empty() ? "" : " after ", s.input.c_str());
+    }
+
+    if (path.empty()) return true;
+
+    auto summary = [](const std::vector<double>& sorted) {
+        return nlohmann::json{
+            {"frames", sorted.size()},
+            {"p50Ms", percentile(sorted, 0.50)},
+            {"p95Ms", percentile(sorted, 0.95)},
+            {"p99Ms", percentile(sorted, 0.99)},
+            {"maxMs", percentile(sorted, 1.0)}
+        };
+    };
+
+    nlohmann::json report = {{"all", summary(all)}, {"drawn", summary(drawn)}, {"worst", nlohmann::json::array()}};
+    for (const sample& s : worst) {
+        report["worst"].push_back({{"frame", s.frame}, {"ms", s.ms}, {"drawn", s.drawn}, {"input", s.input}});
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << report.dump(2) << '\n';
+    if (!out) {
+        TraceLog(LOG_WARNING, "REPLAY: could not write %s", path.c_str());
+        return false;
+    }
+    TraceLog(LOG_INFO, "REPLAY: report written to %s", path.c_str());
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "input.h"
+
+// ============================================================================
+// INPUT RECORDING AND REPLAY
+// ============================================================================
+//
+// A recording is NDJSON: a header line, then one InputFrame per main loop
+// iteration, fields left out when empty:
+//
+//   {"version":1,"width":1920,"height":1080}
+//   {"t":3.1021,"dt":0.0167,"c":[104,105],"k":[257],"m":[812,440],"md":[0,0],"w":0,"bp":1,"bd":1,"br":0}
+//
+// Replay plays the frames back at their recorded times, against a stubbed
+// fetcher, and frameTimeReport turns the result into percentiles and the
+// worst hitches.
+
+struct inputRecordingHeader {
+    int version = 1;
+    int width = 0;
+    int height = 0;
+};
+
+class inputRecorder {
+public:
+    bool open(const std::string& path, const inputRecordingHeader& header);
+    void write(const InputFrame& frame);
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return out.is_open(); }
+    [[nodiscard]] size_t framesWritten() const { return frames; }
+
+private:
+    std::ofstream out;
+    size_t frames{0};
+};
+
+class inputPlayer {
+public:
+    // Reads the whole file up front, so playback never waits on the disk
+    bool open(const std::string& path);
+
+    // False once every frame has been played
+    bool next(InputFrame& frame);
+
+    [[nodiscard]] const inputRecordingHeader& header() const { return info; }
+    [[nodiscard]] size_t frameCount() const { return frames.size(); }
+    [[nodiscard]] size_t framesPlayed() const { return position; }
+
+    // Recorded time of the next frame relative to the first, for pacing
+    [[nodiscard]] double nextOffset() const;
+
+    [[nodiscard]] const std::string& error() const { return lastError; }
+
+private:
+    inputRecordingHeader info;
+    std::vector<InputFrame> frames;
+    size_t position{0};
+    std::string lastError;
+};
+
+// Work time of each replayed frame, from the top of the loop to the end of
+// EndDrawing() (or to the point where an idle frame would have gone to sleep)
+class frameTimeReport {
+public:
+    static constexpr size_t WORST_FRAMES = 10;
+
+    void add(size_t frameIndex, double ms, bool drawn, const InputFrame& input);
+
+    // Logs the summary; writes it as JSON too when path is not empty
+    bool write(const std::string& path) const;
+
+private:
+    struct sample {
+        size_t frame;
+        double ms;
+        bool drawn;
+        std::string input;
+    };
+
+    std::vector<sample> samples;
+
+    // "Enter", "'ab'", "click" ... for naming the frames worth looking at
+    static std::string describe(const InputFrame& input);
+};
+
+#endif // INPUT_RECORDING_H
@@ -0,0 +1,190 @@
+#include "profiler.h"
+
+#if defined(DICTIONARY_PROFILING)
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+profiler& profiler::instance() {
+    static profiler shared;
+    return shared;
+}
+
+uint64_t profiler::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+profiler::threadBuffer& profiler::bufferForThisThread() {
+    thread_local std::shared_ptr<threadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<threadBuffer>();
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer->id = static_cast<uint32_t>(buffers.size() + 1);
+        buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void profiler::record(const char* name, uint64_t startNs, uint64_t endNs, uint64_t selfNs) {
+    bool trace = isTracing();
+    if (!trace && !isCollecting()) return;
+
+    threadBuffer& buffer = bufferForThisThread();
+    uint64_t duration = endNs - startNs;
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    // A handful of distinct phases per thread, so a linear scan beats hashing
+    auto it = std::find_if(buffer.phases.begin(), buffer.phases.end(),
+                           [name](const phaseTotals& p) { return p.name == name; });
+    if (it == buffer.phases.end()) {
+        buffer.phases.push_back({name, 0, 0, 0, 0});
+        it = buffer.phases.end() - 1;
+    }
+    it->totalNs += duration;
+    it->selfNs += selfNs;
+    it->maxNs = std::max(it->maxNs, duration);
+    it->calls++;
+
+    if (trace) {
+        if (buffer.events.size() < MAX_TRACE_EVENTS) buffer.events.push_back({name, startNs, duration});
+        else buffer.droppedEvents++;
+    }
+}
+
+void profiler::setCollecting(bool enabled) {
+    collecting.store(enabled, std::memory_order_relaxed);
+}
+
+void profiler::beginFrame() {
+    frameStartNs = nowNs();
+    if (renderThread == 0) renderThread = bufferForThisThread().id;
+}
+
+void profiler::endFrame() {
+    uint64_t endNs = nowNs();
+    uint64_t frameNs = endNs - frameStartNs;
+
+    // The frame itself, so a trace shows where each one starts
+    record("frame", frameStartNs, endNs, 0);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    history[historyNext] = static_cast<float>(frameNs / 1e6);
+    historyNext = (historyNext + 1) % FRAME_HISTORY;
+
+    // Merge every thread's phases into the window, leaving the threads empty
+    for (const auto& buffer : buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        bool background = buffer->id != renderThread;
+
+        for (const phaseTotals& phase : buffer->phases) {
+            size_t i = 0;
+            while (i < window.size() && (window[i].name != phase.name || windowBackground[i] != background)) i++;
+            if (i == window.size()) {
+                window.push_back({phase.name, 0, 0, 0, 0});
+                windowBackground.push_back(background);
+            }
+            window[i].totalNs += phase.totalNs;
+            window[i].selfNs += phase.selfNs;
+            window[i].maxNs = std::max(window[i].maxNs, phase.maxNs);
+            window[i].calls += phase.calls;
+        }
+        buffer->phases.clear();
+    }
+
+    if (++windowFrames < SUMMARY_FRAMES) return;
+
+    summary.clear();
+    double frames = static_cast<double>(windowFrames);
+    for (size_t i = 0; i < window.size(); ++i) {
+        const phaseTotals& phase = window[i];
+        if (std::strcmp(phase.name, "frame") == 0) continue;
+        summary.push_back({phase.name, phase.totalNs / 1e6 / frames, phase.selfNs / 1e6 / frames,
+                           phase.maxNs / 1e6, static_cast<double>(phase.calls) / frames, windowBackground[i]});
+    }
+    std::sort(summary.begin(), summary.end(),
+              [](const profilePhase& a, const profilePhase& b) { return a.totalMs > b.totalMs; });
+
+    window.clear();
+    windowBackground.clear();
+    windowFrames = 0;
+}
+
+void profiler::startTrace() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& buffer : buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+        buffer->droppedEvents = 0;
+    }
+    traceStartNs = nowNs();
+    tracing.store(true, std::memory_order_relaxed);
+}
+
+// Scope names are literals from this codebase, but keep the JSON valid regardless
+static void writeJsonString(std::ofstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out << '\\' << *c;
+        else if (static_cast<unsigned char>(*c) >= 0x20) out << *c;
+    }
+    out << '"';
+}
+
+bool profiler::stopTrace(const std::string& path) {
+    tracing.store(false, std::memory_order_relaxed);
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+
+    // Chrome trace event format: complete ("X") events in microseconds
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& buffer : buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+
+        if (!first) out << ",\n";
+        first = false;
+        out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":\""
+            << (buffer->id == renderThread ? "render" : "worker " + std::to_string(buffer->id)) << "\"}}";
+
+        for (const traceEvent& event : buffer->events) {
+            if (event.startNs < traceStartNs) continue;
+            out << ",\n{\"ph\":\"X\",\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"pid\":1,\"tid\":" << buffer->id << ",\"ts\":" << (event.startNs - traceStartNs) / 1000.0
+                << ",\"dur\":" << event.durationNs / 1000.0 << "}";
+        }
+        if (buffer->droppedEvents > 0) {
+            out << ",\n{\"ph\":\"i\",\"s\":\"t\",\"name\":\"" << buffer->droppedEvents
+                << " events dropped\",\"pid\":1,\"tid\":" << buffer->id << ",\"ts\":0}";
+        }
+
+        buffer->events.clear();
+        buffer->events.shrink_to_fit();
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+std::vector<float> profiler::frameTimes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<float> times;
+    times.reserve(FRAME_HISTORY);
+    for (size_t i = 0; i < FRAME_HISTORY; ++i) times.push_back(history[(historyNext + i) % FRAME_HISTORY]);
+    return times;
+}
+
+std::vector<profilePhase> profiler::phases() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return summary;
+}
+
+#endif // DICTIONARY_PROFILING
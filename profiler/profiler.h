@@ -0,0 +1,167 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// ============================================================================
+// FRAME PROFILER
+// ============================================================================
+//
+// Scoped timers for finding where frame time goes:
+//
+//   PROFILE_SCOPE("dataScreen::buildUI");   // times the rest of the block
+//
+// Names must be string literals; they are kept by pointer. Scopes nest, and
+// every phase is reported with both its total and its self time (total minus
+// nested scopes). Any thread may open scopes; the render thread brackets each
+// loop iteration with PROFILE_FRAME_BEGIN() / PROFILE_FRAME_END(), and phases
+// from other threads are summed into whichever frame they finished in.
+//
+// Everything is compiled in only when DICTIONARY_PROFILING is defined (the
+// CMake option of the same name). Without it the macros expand to nothing and
+// this header declares nothing else.
+//
+// With it, a scope costs two clock reads. Phases are only accumulated while
+// someone is looking (setCollecting(), the HUD) or a trace is being captured.
+
+#if defined(DICTIONARY_PROFILING)
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One row of the per-phase breakdown, averaged per frame over the last window
+struct profilePhase {
+    const char* name = nullptr;
+    double totalMs = 0.0;
+    double selfMs = 0.0;
+    double maxMs = 0.0;      // longest single call in the window
+    double calls = 0.0;
+    bool background = false; // finished on a thread other than the render thread
+};
+
+class profiler {
+public:
+    static constexpr size_t FRAME_HISTORY = 240;
+    static constexpr int SUMMARY_FRAMES = 30;
+    static constexpr size_t MAX_TRACE_EVENTS = 1 << 20; // per thread
+
+    static profiler& instance();
+
+    static uint64_t nowNs();
+
+    // Render thread, around the work of one loop iteration
+    void beginFrame();
+    void endFrame();
+
+    // Any thread; called when a scope closes
+    void record(const char* name, uint64_t startNs, uint64_t endNs, uint64_t selfNs);
+
+    void setCollecting(bool enabled);
+    [[nodiscard]] bool isCollecting() const { return collecting.load(std::memory_order_relaxed); }
+
+    // Keeps every scope from every thread until stopTrace() writes them out as
+    // Chrome trace event JSON (chrome://tracing, ui.perfetto.dev)
+    void startTrace();
+    bool stopTrace(const std::string& path);
+    [[nodiscard]] bool isTracing() const { return tracing.load(std::memory_order_relaxed); }
+
+    // Work time of the last FRAME_HISTORY frames in ms, oldest first
+    [[nodiscard]] std::vector<float> frameTimes() const;
+
+    // Phases of the last complete window, slowest first
+    [[nodiscard]] std::vector<profilePhase> phases() const;
+
+private:
+    struct traceEvent {
+        const char* name;
+        uint64_t startNs;
+        uint64_t durationNs;
+    };
+
+    struct phaseTotals {
+        const char* name;
+        uint64_t totalNs;
+        uint64_t selfNs;
+        uint64_t maxNs;
+        uint64_t calls;
+    };
+
+    // One per thread that ever closed a scope; outlives the thread so its
+    // trace events can still be written
+    struct threadBuffer {
+        std::mutex mutex;
+        uint32_t id = 0;
+        std::vector<phaseTotals> phases;
+        std::vector<traceEvent> events;
+        size_t droppedEvents = 0;
+    };
+
+    profiler() = default;
+
+    threadBuffer& bufferForThisThread();
+
+    std::atomic<bool> collecting{false};
+    std::atomic<bool> tracing{false};
+
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<threadBuffer>> buffers;
+    uint32_t renderThread = 0;
+    uint64_t traceStartNs = 0;
+
+    uint64_t frameStartNs = 0;
+    std::array<float, FRAME_HISTORY> history{};
+    size_t historyNext = 0;
+
+    std::vector<phaseTotals> window;
+    std::vector<bool> windowBackground;
+    int windowFrames = 0;
+    std::vector<profilePhase> summary;
+};
+
+class profileScope {
+public:
+    explicit profileScope(const char* name) : name(name), parent(current()), startNs(profiler::nowNs()) {
+        current() = this;
+    }
+
+    ~profileScope() {
+        uint64_t endNs = profiler::nowNs();
+        uint64_t duration = endNs - startNs;
+        current() = parent;
+        if (parent) parent->childNs += duration;
+        profiler::instance().record(name, startNs, endNs, duration - childNs);
+    }
+
+    profileScope(const profileScope&) = delete;
+    profileScope& operator=(const profileScope&) = delete;
+
+private:
+    const char* name;
+    profileScope* parent;
+    uint64_t startNs;
+    uint64_t childNs = 0;
+
+    static profileScope*& current() {
+        thread_local profileScope* innermost = nullptr;
+        return innermost;
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) profileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_FRAME_BEGIN() profiler::instance().beginFrame()
+#define PROFILE_FRAME_END() profiler::instance().endFrame()
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+
+#endif // DICTIONARY_PROFILING
+
+#endif // PROFILER_H
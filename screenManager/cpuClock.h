@@ -0,0 +1,8 @@
+#ifndef CPU_CLOCK_H
+#define CPU_CLOCK_H
+
+// CPU time this process has used so far, user plus kernel, in seconds.
+// Kept out of the raylib translation units: windows.h clashes with raylib.h.
+double processCpuSeconds();
+
+#endif // CPU_CLOCK_H
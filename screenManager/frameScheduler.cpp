@@ -0,0 +1,108 @@
+#include "frameScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <raylib.h>
+
+#if defined(DICTIONARY_RAYLIB_GLFW)
+// From the GLFW raylib itself links; see CMakeLists.txt
+extern "C" {
+void glfwWaitEvents(void);
+void glfwWaitEventsTimeout(double timeout);
+void glfwPostEmptyEvent(void);
+}
+#endif
+
+frameScheduler& frameScheduler::instance() {
+    static frameScheduler scheduler;
+    return scheduler;
+}
+
+void frameScheduler::attach() {
+    std::lock_guard<std::mutex> lock(mutex);
+    attached = true;
+}
+
+void frameScheduler::detach() {
+    std::lock_guard<std::mutex> lock(mutex);
+    attached = false;
+    frameRequested = false;
+}
+
+void frameScheduler::requestFrame() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!attached) return;
+
+        counters.requests++;
+        frameRequested = true;
+#if defined(DICTIONARY_RAYLIB_GLFW)
+        // Held across the post so detach() cannot slip in before the window goes
+        glfwPostEmptyEvent();
+#endif
+    }
+    wakeUp.notify_one();
+}
+
+#if defined(DICTIONARY_RAYLIB_GLFW)
+
+void frameScheduler::waitForEvents(double timeout, bool) {
+    double start = GetTime();
+    bool requested;
+    {
+        // A request from here on posts an event the wait below returns for
+        std::lock_guard<std::mutex> lock(mutex);
+        requested = frameRequested;
+    }
+
+    // raylib snapshots last frame's input and clears its key and char queues
+    // here, so everything the wait delivers is seen by the next update()
+    PollInputEvents();
+    bool block = !requested && timeout < 0.0;
+    if (block) glfwWaitEvents();
+    else if (!requested) glfwWaitEventsTimeout(timeout);
+
+    // Whatever was requested so far is ready for the update() that follows
+    std::lock_guard<std::mutex> lock(mutex);
+    frameRequested = false;
+    counters.waits++;
+    if (block) counters.blocked++;
+    counters.idleSeconds += GetTime() - start;
+}
+
+#else
+
+void frameScheduler::waitForEvents(double timeout, bool backgroundPending) {
+    double start = GetTime();
+    bool block = timeout < 0.0 && !backgroundPending;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (frameRequested) {
+            block = false;
+        }
+        else if (!block) {
+            auto step = std::chrono::duration<double>(timeout < 0.0 ? POLL_INTERVAL : std::min(timeout, POLL_INTERVAL));
+            wakeUp.wait_for(lock, step, [this]() { return frameRequested; });
+        }
+        frameRequested = false;
+    }
+
+    // raylib snapshots last frame's input and clears its key and char queues
+    // here, then collects what arrived, so the next update() sees all of it.
+    // With event waiting on, the collecting blocks until an input event.
+    if (block) EnableEventWaiting();
+    PollInputEvents();
+    if (block) DisableEventWaiting();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    counters.waits++;
+    if (block) counters.blocked++;
+    counters.idleSeconds += GetTime() - start;
+}
+
+#endif
+
+frameSchedulerStats frameScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
@@ -0,0 +1,61 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <condition_variable>
+#include <mutex>
+
+struct frameSchedulerStats {
+    unsigned long long waits = 0;     // frames that slept instead of drawing
+    unsigned long long blocked = 0;   // of those, waits with no timed wakeup
+    unsigned long long requests = 0;  // requestFrame() calls that reached the window
+    double idleSeconds = 0.0;         // time spent asleep
+};
+
+// Lets the main loop sleep while nothing on screen can change.
+//
+// Built with DICTIONARY_RAYLIB_GLFW (CMake defines it when raylib's own GLFW
+// is reachable), a wait blocks in GLFW's event wait for the whole timeout,
+// or with no timeout until input. requestFrame() posts an empty event that
+// ends it from any thread.
+//
+// Otherwise it goes through raylib alone, which can neither time an event
+// wait out nor wake one from another thread. With nothing due and no
+// background work outstanding, the loop blocks in raylib's event waiting
+// until the next input event. While something is due, or background work may
+// still call requestFrame(), it sleeps at most POLL_INTERVAL at a time
+// instead, so input is still seen within a frame at 60 Hz and requestFrame()
+// ends the sleep at once.
+class frameScheduler {
+public:
+    static constexpr double POLL_INTERVAL = 1.0 / 60.0;
+
+    static frameScheduler& instance();
+
+    // Between InitWindow() and CloseWindow(); requestFrame() does nothing outside
+    void attach();
+    void detach();
+
+    // Any thread. Ends the current timed wait, or makes the next one return at once.
+    void requestFrame();
+
+    // Render thread, in place of EndDrawing() on a frame that draws nothing.
+    // Polls input the way EndDrawing() would and sleeps until input, a
+    // requestFrame() or the timeout in seconds; a negative timeout has none.
+    // Without raylib's GLFW the sleep is cut to POLL_INTERVAL, except that a
+    // negative timeout with backgroundPending false blocks until an input
+    // event: only say so when no thread can still call requestFrame().
+    void waitForEvents(double timeout, bool backgroundPending);
+
+    [[nodiscard]] frameSchedulerStats stats() const;
+
+private:
+    frameScheduler() = default;
+
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool attached{false};
+    bool frameRequested{false};
+    frameSchedulerStats counters;
+};
+
+#endif // FRAME_SCHEDULER_H
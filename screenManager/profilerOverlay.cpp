@@ -0,0 +1,107 @@
+#include "profilerOverlay.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <ctime>
+#include <string>
+#include <raylib.h>
+
+#if defined(DICTIONARY_PROFILING)
+
+constexpr int PANEL_WIDTH = 560;
+constexpr int GRAPH_HEIGHT = 120;
+constexpr int ROW_HEIGHT = 20;
+constexpr int TEXT_SIZE = 18;
+constexpr size_t MAX_PHASE_ROWS = 14;
+constexpr float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+
+constexpr Color PANEL_BG = Color{10, 10, 10, 210};
+constexpr Color BAR_OK = Color{90, 200, 120, 255};
+constexpr Color BAR_SLOW = Color{230, 90, 70, 255};
+constexpr Color BUDGET_LINE = Color{240, 200, 80, 160};
+constexpr Color TEXT_DIM = Color{170, 170, 170, 255};
+
+void profilerOverlay::toggle() {
+    visible = !visible;
+    profiler::instance().setCollecting(visible);
+}
+
+void profilerOverlay::toggleTrace() {
+    profiler& shared = profiler::instance();
+    if (!shared.isTracing()) {
+        shared.startTrace();
+        TraceLog(LOG_INFO, "PROFILER: trace started, F5 again to write it");
+        return;
+    }
+
+    char stamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", std::localtime(&now));
+    std::string path = std::string("trace-") + stamp + ".json";
+
+    if (shared.stopTrace(path)) TraceLog(LOG_INFO, "PROFILER: trace written to %s", path.c_str());
+    else TraceLog(LOG_WARNING, "PROFILER: could not write %s", path.c_str());
+}
+
+void profilerOverlay::draw(int screenWidth) const {
+    if (!visible) return;
+
+    profiler& shared = profiler::instance();
+    std::vector<float> frames = shared.frameTimes();
+    std::vector<profilePhase> phases = shared.phases();
+    size_t rows = std::min(phases.size(), MAX_PHASE_ROWS);
+
+    int x = screenWidth - PANEL_WIDTH - 10;
+    int y = 10;
+    int height = 40 + GRAPH_HEIGHT + 30 + ROW_HEIGHT * static_cast<int>(rows + 1);
+    DrawRectangle(x, y, PANEL_WIDTH, height, PANEL_BG);
+
+    float worst = 0.0f;
+    float sum = 0.0f;
+    int counted = 0;
+    for (float ms : frames) {
+        if (ms <= 0.0f) continue; // not filled yet
+        worst = std::max(worst, ms);
+        sum += ms;
+        counted++;
+    }
+
+    DrawText(TextFormat("frame work  avg %.2f ms  max %.2f ms%s", counted > 0 ? sum / counted : 0.0f, worst,
+                        shared.isTracing() ? "  [REC F5]" : "  (F5 trace)"),
+             x + 10, y + 10, TEXT_SIZE, RAYWHITE);
+
+    // Bars scale to two frame budgets, or further when a frame took longer
+    int graphTop = y + 40;
+    float scaleMs = std::max(worst, 2.0f * FRAME_BUDGET_MS);
+    float barWidth = static_cast<float>(PANEL_WIDTH - 20) / static_cast<float>(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        float barHeight = frames[i] / scaleMs * GRAPH_HEIGHT;
+        DrawRectangleRec({x + 10 + barWidth * static_cast<float>(i), graphTop + GRAPH_HEIGHT - barHeight,
+                          std::max(barWidth - 1.0f, 1.0f), barHeight},
+                         frames[i] > FRAME_BUDGET_MS ? BAR_SLOW : BAR_OK);
+    }
+    int budgetY = graphTop + GRAPH_HEIGHT - static_cast<int>(FRAME_BUDGET_MS / scaleMs * GRAPH_HEIGHT);
+    DrawLine(x + 10, budgetY, x + PANEL_WIDTH - 10, budgetY, BUDGET_LINE);
+
+    // Per-phase breakdown, per frame over the last window
+    int tableY = graphTop + GRAPH_HEIGHT + 20;
+    DrawText("phase", x + 10, tableY, TEXT_SIZE, TEXT_DIM);
+    DrawText("total", x + 300, tableY, TEXT_SIZE, TEXT_DIM);
+    DrawText("self", x + 370, tableY, TEXT_SIZE, TEXT_DIM);
+    DrawText("max", x + 430, tableY, TEXT_SIZE, TEXT_DIM);
+    DrawText("calls", x + 490, tableY, TEXT_SIZE, TEXT_DIM);
+
+    for (size_t i = 0; i < rows; ++i) {
+        const profilePhase& phase = phases[i];
+        int rowY = tableY + ROW_HEIGHT * static_cast<int>(i + 1);
+        Color color = phase.background ? TEXT_DIM : RAYWHITE;
+
+        DrawText(TextFormat("%s%s", phase.name, phase.background ? " (bg)" : ""), x + 10, rowY, TEXT_SIZE, color);
+        DrawText(TextFormat("%.2f", phase.totalMs), x + 300, rowY, TEXT_SIZE, color);
+        DrawText(TextFormat("%.2f", phase.selfMs), x + 370, rowY, TEXT_SIZE, color);
+        DrawText(TextFormat("%.1f", phase.maxMs), x + 430, rowY, TEXT_SIZE, color);
+        DrawText(TextFormat("%.1f", phase.calls), x + 490, rowY, TEXT_SIZE, color);
+    }
+}
+
+#endif // DICTIONARY_PROFILING
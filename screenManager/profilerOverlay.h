@@ -0,0 +1,28 @@
+#ifndef PROFILER_OVERLAY_H
+#define PROFILER_OVERLAY_H
+
+// On-screen view of the frame profiler: a frame-time graph and the slowest
+// phases of the last summary window. Only defined with DICTIONARY_PROFILING,
+// like the profiler itself.
+
+#if defined(DICTIONARY_PROFILING)
+
+class profilerOverlay {
+public:
+    // Toggles the overlay and, with it, phase collection
+    void toggle();
+    [[nodiscard]] bool isVisible() const { return visible; }
+
+    // Starts a trace, or stops the running one and writes it to
+    // trace-<date>-<time>.json in the working directory
+    void toggleTrace();
+
+    void draw(int screenWidth) const;
+
+private:
+    bool visible{false};
+};
+
+#endif // DICTIONARY_PROFILING
+
+#endif // PROFILER_OVERLAY_H
@@ -1,21 +1,92 @@
+#include <algorithm>
+#include <thread>
 #include <raylib.h>
 #include "screenManager.h"
+#include "headwords.h"
+#include "hedgedClient.h"
+#include "fontManager.h"
+#include "frameScheduler.h"
+#include "cpuClock.h"
+#include "profiler.h"
 
 constexpr Color BG = Color{45, 20, 25, 255};
 
 screenManager::screenManager(float screenWidth, float screenHeight)
     : screenWidth(screenWidth), screenHeight(screenHeight),
-      currentScreen(nullptr), currentScreenType(screenType::Search) {}
+      currentScreen(nullptr), currentScreenType(screenType::Search), showLayoutStats(false),
+      eventDriven(true), forceRedraw(true), framesDrawn(0), runStartTime(0.0), runStartCpu(0.0),
+      prefetchDebounce(lookupPrefetcher::DEFAULT_DEBOUNCE) {}
 
 screenManager::~screenManager() {
     cleanup();
 }
 
+bool screenManager::recordInputTo(const std::string& path) {
+    inputRecordingHeader header;
+    header.width = static_cast<int>(screenWidth);
+    header.height = static_cast<int>(screenHeight);
+    if (!recorder.open(path, header)) return false;
+
+    recordPath = path;
+    Input::mode = Input::Mode::Record;
+    return true;
+}
+
+// Same word, same entry: a replay does the same layout work on every run
+static WordData cannedWordData(const std::string& word) {
+    uint32_t hash = 2166136261u; // FNV-1a, stable across platforms unlike std::hash
+    for (char c : word) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+
+    WordData data;
+    data.word = word;
+    data.phonetic = "/" + word + "/";
+    data.posList = {"noun", "verb"};
+    for (uint32_t i = 0, count = 1 + hash % 12; i < count; ++i) {
+        data.definitionList.push_back("Definition " + std::to_string(i + 1) + " of \"" + word +
+                                      "\", standing in for an API response during an input replay so "
+                                      "that wrapping, layout and drawing have realistic work to do.");
+    }
+    return data;
+}
+
+bool screenManager::replayInputFrom(const std::string& path, const std::string& reportPath,
+                                    std::chrono::milliseconds lookupLatency) {
+    if (!player.open(path)) return false;
+
+    replayReportPath = reportPath;
+    Input::mode = Input::Mode::Replay;
+
+    // Lookups must not depend on the network or on what this machine has cached
+    setFetchOverride([lookupLatency](const std::string& word) {
+        if (lookupLatency.count() > 0) std::this_thread::sleep_for(lookupLatency);
+        return cannedWordData(word);
+    });
+    return true;
+}
+
 void screenManager::initialize() {
     InitWindow(static_cast<int>(screenWidth), static_cast<int>(screenHeight), "Dictionary");
-    SetTargetFPS(60);
+
+    // A replay is paced by the recorded timestamps instead of the frame cap
+    SetTargetFPS(Input::mode == Input::Mode::Replay ? 0 : 60);
+    if (Input::mode == Input::Mode::Replay && (player.header().width != static_cast<int>(screenWidth) ||
+                                                player.header().height != static_cast<int>(screenHeight))) {
+        TraceLog(LOG_WARNING, "REPLAY: recorded at %dx%d, mouse positions may not line up", player.header().width,
+                 player.header().height);
+    }
+
+    // Background work wakes the loop when it finishes instead of being polled for
+    frameScheduler::instance().attach();
+    lookupWorker::instance().setCompletionListener([]() { frameScheduler::instance().requestFrame(); });
+
+    // Suggestion index builds in the background while the first screen loads
+    headwordIndex::instance().startLoading([]() { frameScheduler::instance().requestFrame(); });
 
     schScreen = std::make_unique<searchScreen>(screenWidth, screenHeight);
+    schScreen->setPrefetchDebounce(prefetchDebounce);
     datScreen = std::make_unique<dataScreen>(screenWidth, screenHeight);
 
     switchScreen(screenType::Search);
@@ -39,44 +110,210 @@ void screenManager::switchScreen(screenType screen) {
     if (currentScreen) {
         currentScreen->onEnter();
     }
+    forceRedraw = true;
 }
 
-void screenManager::handleScreenTransitions() {
+bool screenManager::handleScreenTransitions() {
     if (currentScreenType == screenType::Search && schScreen->hasSearched()) {
         std::string word = schScreen->getSearchedWord();
         schScreen->resetSearch();
 
-        datScreen->loadWord(word);
+        datScreen->loadWord(word, schScreen->takePrefetch(word));
         switchScreen(screenType::Data);
+        return true;
     }
-    else if (currentScreenType == screenType::Data && datScreen->hasBackRequested()) {
+    if (currentScreenType == screenType::Data && datScreen->hasBackRequested()) {
         datScreen->resetBackRequest();
         switchScreen(screenType::Search);
+        return true;
+    }
+    return false;
+}
+
+void screenManager::beginInputFrame() {
+    if (Input::mode == Input::Mode::Record) {
+        recorder.write(Input::capture());
+    }
+    else if (Input::mode == Input::Mode::Replay) {
+        // Each frame starts when it did in the recording, so background work
+        // (lookups, the headword index) gets the same head start
+        double due = runStartTime + player.nextOffset();
+        double now = GetTime();
+        if (due > now) WaitTime(due - now);
+
+        InputFrame frame;
+        player.next(frame);
+        Input::play(std::move(frame));
+    }
+}
+
+void screenManager::endInputFrame(double frameStart, bool drawn) {
+    PROFILE_FRAME_END();
+    if (Input::mode == Input::Mode::Replay) {
+        replayReport.add(player.framesPlayed() - 1, (GetTime() - frameStart) * 1000.0, drawn, Input::frame);
     }
 }
 
 void screenManager::run() {
+    runStartTime = GetTime();
+    runStartCpu = processCpuSeconds();
+
     while (!WindowShouldClose()) {
-        handleScreenTransitions();
+        // A replay ends with its recording
+        if (Input::mode == Input::Mode::Replay && player.framesPlayed() == player.frameCount()) break;
+
+        beginInputFrame();
+        double frameStart = GetTime();
+
+        PROFILE_FRAME_BEGIN();
+        LayoutStats::beginFrame();
+        RenderStats::beginFrame();
+
+        // F3 shows how much layout and drawing each frame does; an idle screen
+        // should read 0 passes and 0 cache renders
+        if (Input::keyPressed(KEY_F3)) {
+            showLayoutStats = !showLayoutStats;
+            forceRedraw = true;
+        }
+
+#if defined(DICTIONARY_PROFILING)
+        // F4 shows where frame time goes, F5 starts and stops a trace file
+        if (Input::keyPressed(KEY_F4)) {
+            profilerHud.toggle();
+            forceRedraw = true;
+        }
+        if (Input::keyPressed(KEY_F5)) {
+            profilerHud.toggleTrace();
+            forceRedraw = true;
+        }
+#endif
+
+        {
+            PROFILE_SCOPE("handleScreenTransitions");
+            handleScreenTransitions();
+        }
 
         if (currentScreen) {
+            PROFILE_SCOPE("Screen::update");
             currentScreen->update();
         }
 
+        bool redraw = !eventDriven || forceRedraw || (currentScreen && currentScreen->needsRedraw());
+        if (!redraw) {
+            endInputFrame(frameStart, false);
+
+            // Replay paces itself; it only keeps the window responsive
+            if (Input::mode == Input::Mode::Replay) {
+                PollInputEvents();
+                continue;
+            }
+
+            // Nothing changed: sleep until input, finished background work or
+            // the screen's next timed change, but never spin faster than 60 Hz.
+            // The raylib-only wait needs to know whether a lookup or index
+            // build can still report back before it may leave waking to input.
+            double timeout = currentScreen ? currentScreen->nextWakeup() : -1.0;
+            if (timeout >= 0.0) timeout = std::max(timeout, 1.0 / 60.0);
+            bool backgroundPending = !lookupWorker::instance().idle() || headwordIndex::instance().isLoading();
+            frameScheduler::instance().waitForEvents(timeout, backgroundPending);
+            continue;
+        }
+        forceRedraw = false;
+        framesDrawn++;
+
         BeginDrawing();
         ClearBackground(BG);
         
         if (currentScreen) {
+            PROFILE_SCOPE("Screen::draw");
             currentScreen->draw();
         }
-        
-        EndDrawing();
+
+        if (showLayoutStats) {
+            DrawText(TextFormat("layout passes: %d", LayoutStats::passesThisFrame), 10, 10, 20, RAYWHITE);
+            DrawText(TextFormat("draws: %d  cache renders: %d", RenderStats::drawsThisFrame,
+                                RenderStats::cacheRendersThisFrame), 10, 34, 20, RAYWHITE);
+        }
+
+#if defined(DICTIONARY_PROFILING)
+        profilerHud.draw(static_cast<int>(screenWidth));
+#endif
+
+        {
+            // Includes the wait for the target frame rate
+            PROFILE_SCOPE("EndDrawing");
+            EndDrawing();
+        }
+        endInputFrame(frameStart, true);
     }
 }
 
 void screenManager::cleanup() {
+    // main() bails out before initialize() when a recording cannot be opened
+    if (!IsWindowReady()) return;
+
     if (currentScreen) {
         currentScreen->onExit();
     }
+
+    fontManagerStats fonts = fontManager::instance().stats();
+    TraceLog(LOG_INFO, "FONTS: %zu resident (%zu in use), %zu KiB textures, %zu KiB glyphs, %llu loads, %llu reused",
+             fonts.residentFonts, fonts.referencedFonts, fonts.textureBytes / 1024, fonts.glyphBytes / 1024,
+             static_cast<unsigned long long>(fonts.loads), static_cast<unsigned long long>(fonts.hits));
+
+    // Compare a session left idle on a definition with and without --continuous
+    double wallSeconds = GetTime() - runStartTime;
+    double cpuSeconds = processCpuSeconds() - runStartCpu;
+    frameSchedulerStats idle = frameScheduler::instance().stats();
+    TraceLog(LOG_INFO, "FRAMES: %llu drawn, %llu slept (%llu until input, %.1f s asleep), %.1f%% of one core over %.1f s (%s)",
+             framesDrawn, idle.waits, idle.blocked, idle.idleSeconds,
+             wallSeconds > 0.0 ? cpuSeconds * 100.0 / wallSeconds : 0.0,
+             wallSeconds, eventDriven ? "event-driven" : "continuous");
+
+    // How often typing pauses turned into a lookup that was actually wanted
+    lookupPrefetcherStats prefetch = schScreen ? schScreen->prefetchStats() : lookupPrefetcherStats{};
+    TraceLog(LOG_INFO, "PREFETCH: %llu issued, %llu used (%llu already done), %llu superseded, %llu abandoned, "
+             "%llu commits missed; %.0f%% useful",
+             prefetch.issued, prefetch.used(), prefetch.usedReady, prefetch.superseded, prefetch.abandoned,
+             prefetch.missed, prefetch.usefulRate() * 100.0);
+
+    singleFlightStats flights = coalescingStats();
+    TraceLog(LOG_INFO, "LOOKUPS: %llu went past the memory cache, %llu coalesced into one already in flight",
+             static_cast<unsigned long long>(flights.started), static_cast<unsigned long long>(flights.coalesced));
+
+    hedgedClientStats network = hedgedClient::instance().stats();
+    TraceLog(LOG_INFO, "NETWORK: %llu requests, %llu hedged (%llu won), %llu retries, %llu timeouts; "
+             "hedging after %.0f ms, timeout %.0f ms",
+             static_cast<unsigned long long>(network.requests), static_cast<unsigned long long>(network.hedges),
+             static_cast<unsigned long long>(network.hedgeWins), static_cast<unsigned long long>(network.retries),
+             static_cast<unsigned long long>(network.timeouts), network.hedgeAfterMs, network.timeoutMs);
+
+    TextMeasureStats measured = TextMeasure::stats();
+    TraceLog(LOG_INFO, "TEXT: %.1f%% measure cache hits (%llu lookups), %llu glyph advances looked up",
+             measured.hitRate() * 100.0, measured.hits + measured.misses, measured.glyphMisses);
+
+    if (recorder.isOpen()) {
+        TraceLog(LOG_INFO, "INPUT: %zu frames recorded to %s", recorder.framesWritten(), recordPath.c_str());
+        recorder.close();
+    }
+    if (Input::mode == Input::Mode::Replay) {
+        replayReport.write(replayReportPath);
+        setFetchOverride(nullptr);
+    }
+
+#if defined(DICTIONARY_PROFILING)
+    // A trace still running at exit is written rather than lost
+    if (profiler::instance().isTracing()) profilerHud.toggleTrace();
+#endif
+
+    // Lookups touch the caches, which are statics that may be destroyed
+    // before the worker's own static; stop them while everything is alive
+    lookupWorker::instance().setCompletionListener(nullptr);
+    lookupWorker::instance().shutdown();
+    hedgedClient::shutdown();
+
+    // Textures have to go before the GL context does
+    frameScheduler::instance().detach();
+    fontManager::instance().unloadAll();
     CloseWindow();
 }
@@ -1,10 +1,15 @@
 #ifndef SCREEN_MANAGER_H
 #define SCREEN_MANAGER_H
 
+#include <chrono>
 #include <memory>
+#include <string>
 #include "screen.h"
 #include "searchScreen.h"
 #include "dataScreen.h"
+#include "ui.h"
+#include "profilerOverlay.h"
+#include "inputRecording.h"
 
 class screenManager {
 public:
@@ -21,6 +26,23 @@ public:
     void cleanup();
     void switchScreen(screenType screen);
 
+    // Off: draw every frame at the target FPS, as before idle mode existed.
+    // Handy for comparing the two.
+    void setEventDriven(bool enabled) { eventDriven = enabled; }
+
+    // How long typing has to pause before the search screen prefetches; zero turns it off
+    void setPrefetchDebounce(std::chrono::milliseconds interval) { prefetchDebounce = interval; }
+
+    // Writes the input of every frame to path (see inputRecording.h)
+    bool recordInputTo(const std::string& path);
+
+    // Plays a recording back in place of the keyboard and mouse, with canned
+    // lookups that take lookupLatency each. Frame times are logged at the end,
+    // and written to reportPath as JSON when it is not empty.
+    bool replayInputFrom(const std::string& path, const std::string& reportPath,
+                         std::chrono::milliseconds lookupLatency);
+    [[nodiscard]] const std::string& replayError() const { return player.error(); }
+
 private:
     float screenWidth;
     float screenHeight;
@@ -30,8 +52,31 @@ private:
 
     Screen* currentScreen;
     screenType currentScreenType;
+    bool showLayoutStats;
+
+    // Idle mode: frames are only drawn when the screen changed
+    bool eventDriven;
+    bool forceRedraw;
+    unsigned long long framesDrawn;
+    double runStartTime;
+    double runStartCpu;
+
+    std::chrono::milliseconds prefetchDebounce;
+
+    // Input recording and replay
+    std::string recordPath;
+    inputRecorder recorder;
+    inputPlayer player;
+    frameTimeReport replayReport;
+    std::string replayReportPath;
+
+#if defined(DICTIONARY_PROFILING)
+    profilerOverlay profilerHud;
+#endif
 
-    void handleScreenTransitions();
+    bool handleScreenTransitions();
+    void beginInputFrame();
+    void endInputFrame(double frameStart, bool drawn);
 };
 
 #endif // SCREEN_MANAGER_H
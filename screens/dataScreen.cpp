@@ -1,4 +1,5 @@
 #include "dataScreen.h"
+#include "profiler.h"
 #include <iostream>
 
 // Font sizes
@@ -20,44 +21,185 @@ constexpr Color TEXT_PRIMARY = Color{240, 200, 200, 255};
 constexpr Color TEXT_ACCENT = Color{220, 120, 120, 255};
 
 dataScreen::dataScreen(float screenWidth, float screenHeight)
-    : screenWidth(screenWidth), screenHeight(screenHeight), shouldGoBack(false) {}
+    : screenWidth(screenWidth), screenHeight(screenHeight), shouldGoBack(false),
+      isLoading(false) {}
 
 void dataScreen::onEnter() { shouldGoBack = false; }
 void dataScreen::onExit() {
+    // Leaving while the lookup is in flight: its result is no longer wanted
+    pendingLookup.cancel();
+    pendingLookup = lookupHandle{};
+    isLoading = false;
+
     rootFrame.reset();
     unloadFonts();
 }
 
-void dataScreen::loadWord(const std::string& word) {
-    currentWordData = fetchWordData(word);
+void dataScreen::loadWord(const std::string& word, lookupHandle prefetched) {
+    PROFILE_SCOPE("dataScreen::loadWord");
+
+    // A newer word supersedes whatever is still pending
+    pendingLookup.cancel();
+    pendingLookup = lookupHandle{};
+    corrections.clear();
+    ruledOutWord.clear();
+
+    // A complete headword list already rules this word out, skip the network round trip
+    std::vector<spellIndex::correction> found;
+    if (headwordIndex::instance().isKnownMisspelling(normalizeWord(word), &found)) {
+        isLoading = false;
+        prefetched.cancel();
+        for (const auto& candidate : found) corrections.push_back(candidate.word);
+        ruledOutWord = word;
+
+        WordData notFound;
+        notFound.word = "Not Found";
+        notFound.phonetic = "/not_found/";
+        notFound.definitionList.push_back("\"" + word + "\" is not in the dictionary.");
+        notFound.missingWord = true;
+        showResult(notFound);
+        return;
+    }
+
+    startLookup(word, std::move(prefetched));
+}
+
+void dataScreen::startLookup(const std::string& word, lookupHandle prefetched) {
+    pendingLookup = prefetched.valid() ? std::move(prefetched) : lookupWorker::instance().submit(word);
+    isLoading = true;
+
+    // A prefetch that already came back skips the loading screen altogether
+    if (pendingLookup.ready()) {
+        finishLoading();
+        return;
+    }
+    buildLoadingUI(word);
+}
+
+void dataScreen::showWordData(const WordData& data) {
+    pendingLookup.cancel();
+    pendingLookup = lookupHandle{};
+    isLoading = false;
+    corrections.clear();
+    ruledOutWord.clear();
+
+    showResult(data);
+}
+
+void dataScreen::finishLoading() {
+    PROFILE_SCOPE("dataScreen::finishLoading");
+    isLoading = false;
+
+    try {
+        currentWordData = pendingLookup.result.get();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Lookup failed: " << e.what() << std::endl;
+        currentWordData = WordData{};
+        currentWordData.word = "Not Found";
+        currentWordData.phonetic = "/not_found/";
+        currentWordData.definitionList.push_back("Failed to fetch data from the API.");
+    }
+
+    // Only when the API says the word does not exist; a failed lookup proves nothing
+    if (currentWordData.missingWord) {
+        if (auto spell = headwordIndex::instance().spelling()) {
+            for (const auto& candidate : spell->lookup(normalizeWord(pendingLookup.word))) {
+                if (candidate.distance > 0) corrections.push_back(candidate.word);
+            }
+        }
+    }
+    pendingLookup = lookupHandle{};
+
+    showResult(currentWordData);
+}
+
+void dataScreen::showResult(const WordData& data) {
+    currentWordData = data;
+
     loadFonts(currentWordData);
     buildUI(currentWordData);
 }
 
 void dataScreen::loadFonts(const WordData& data) {
-    int codePointsCount = 0;
-    int *codepoints = LoadCodepoints(data.phonetic.c_str(), &codePointsCount);
+    PROFILE_SCOPE("dataScreen::loadFonts");
+    // Handles for the previous word are replaced, not unloaded first, so fonts
+    // used by both words (and by searchScreen) stay resident
+    fontManager& fonts = fontManager::instance();
+    wordFont = fonts.acquire(FONT_TINY5, WORD_FONT_SIZE);
+    posFont = fonts.acquire(FONT_INTER, POS_FONT_SIZE);
+
+    // IPA symbols and typographic punctuation vary per word; the dynamic atlases
+    // rasterize only what this word adds. Runs before buildUI() copies the Fonts.
+    phoneticFont = fonts.acquireDynamic(FONT_NOTO_SANS, PHONETIC_FONT_SIZE);
+    phoneticFont.ensureGlyphs(data.phonetic);
+
+    // One pass over all of the text, so the atlas is uploaded at most once
+    std::string definitionText;
+    for (const auto& definition : data.definitionList) definitionText += definition;
+    for (const auto& correction : corrections) definitionText += correction;
+    if (!ruledOutWord.empty()) definitionText += "Search anyway";
+
+    definitionFont = fonts.acquireDynamic(FONT_MERRIWEATHER, DEFINITION_FONT_SIZE);
+    definitionFont.ensureGlyphs(definitionText);
+}
 
-    // Load fonts
-    wordFont = LoadFontEx(FONT_TINY5, WORD_FONT_SIZE, nullptr, 0);
-    SetTextureFilter(wordFont.texture, TEXTURE_FILTER_POINT);
+void dataScreen::unloadFonts() {
+    wordFont.reset();
+    phoneticFont.reset();
+    posFont.reset();
+    definitionFont.reset();
+}
 
-    phoneticFont = LoadFontEx(FONT_NOTO_SANS, PHONETIC_FONT_SIZE, codepoints, codePointsCount);
-    UnloadCodepoints(codepoints);
-    SetTextureFilter(phoneticFont.texture, TEXTURE_FILTER_POINT);
+void dataScreen::buildLoadingUI(const std::string& word) {
+    // Placeholder shown while the lookup runs, only uses raylib's default font
+    rootFrame = std::make_unique<Frame>(
+        Rectangle{0, 0, screenWidth, screenHeight},
+        BLANK,
+        Padding(0.0f)
+    );
+    rootFrame->layoutMode = Frame::Layout::Vertical;
+    rootFrame->spacing = 0.0f;
 
-    posFont = LoadFontEx(FONT_INTER, POS_FONT_SIZE, nullptr, 0);
-    definitionFont = LoadFontEx(FONT_MERRIWEATHER, DEFINITION_FONT_SIZE, nullptr, 0);
-}
+    auto topBar = std::make_unique<Frame>(
+        Rectangle{0, 0, screenWidth, 80},
+        BLANK,
+        Padding(20.0f)
+    );
+    topBar->layoutMode = Frame::Layout::Horizontal;
+    topBar->align = Alignment{Alignment::Horizontal::Left, Alignment::Vertical::Center};
 
-void dataScreen::unloadFonts() {
-    UnloadFont(wordFont);
-    UnloadFont(phoneticFont);
-    UnloadFont(posFont);
-    UnloadFont(definitionFont);
+    auto backButton = ButtonElement::createAutoSize("< Back", 24, Padding(10.0f, 20.0f),
+        [this]() {
+            shouldGoBack = true;
+            std::cout << "prev screen \n";
+        });
+
+    backButton->style.normalColor = Color{70, 35, 35, 255};
+    backButton->style.hoverColor = Color{90, 45, 45, 255};
+    backButton->style.pressedColor = Color{50, 25, 25, 255};
+    backButton->style.textNormalColor = TEXT_PRIMARY;
+    backButton->style.textHoverColor = WHITE;
+    backButtonPtr = backButton.get();
+
+    topBar->AddChild(std::move(backButton));
+
+    auto headFrame = std::make_unique<Frame>(
+        Rectangle{0, 0, screenWidth, screenHeight / 3 - 40},
+        BG_HEADER,
+        Padding(100.0f, 80.0f)
+    );
+    headFrame->layoutMode = Frame::Layout::Vertical;
+
+    auto loadingText = std::make_unique<TextElement>("Looking up \"" + word + "\"...", PHONETIC_FONT_SIZE, TEXT_ACCENT);
+    headFrame->AddChild(std::move(loadingText));
+
+    rootFrame->AddChild(std::move(topBar));
+    rootFrame->AddChild(std::move(headFrame));
 }
 
 void dataScreen::buildUI(const WordData& data) {
+    PROFILE_SCOPE("dataScreen::buildUI");
     // root frame
     rootFrame = std::make_unique<Frame>(
         Rectangle{0, 0, screenWidth, screenHeight},
@@ -109,14 +251,14 @@ void dataScreen::buildUI(const WordData& data) {
     auto wordElement = std::make_unique<TextElement>(data.word, WORD_FONT_SIZE, TEXT_PRIMARY);
     wordElement->font = wordFont;
     wordElement->useCustomFont = true;
-    Vector2 wordSize = MeasureTextEx(wordFont, data.word.c_str(), static_cast<float>(WORD_FONT_SIZE), 1.0f);
+    Vector2 wordSize = TextMeasure::measure(wordFont, data.word.c_str(), static_cast<float>(WORD_FONT_SIZE), 1.0f);
     wordElement->bounds.width = wordSize.x;
     wordElement->bounds.height = wordSize.y;
 
     auto phoneticElement = std::make_unique<TextElement>(data.phonetic, PHONETIC_FONT_SIZE, TEXT_PRIMARY);
     phoneticElement->font = phoneticFont;
     phoneticElement->useCustomFont = true;
-    Vector2 phoneticSize = MeasureTextEx(phoneticFont, data.phonetic.c_str(), static_cast<float>(PHONETIC_FONT_SIZE), 1.0f);
+    Vector2 phoneticSize = TextMeasure::measure(phoneticFont, data.phonetic.c_str(), static_cast<float>(PHONETIC_FONT_SIZE), 1.0f);
     phoneticElement->bounds.width = phoneticSize.x;
     phoneticElement->bounds.height = phoneticSize.y;
 
@@ -130,7 +272,7 @@ void dataScreen::buildUI(const WordData& data) {
         posElement->font = posFont;
         posElement->useCustomFont = true;
 
-        Vector2 posSize = MeasureTextEx(posFont, posStr.c_str(), static_cast<float>(POS_FONT_SIZE), 1.0f);
+        Vector2 posSize = TextMeasure::measure(posFont, posStr.c_str(), static_cast<float>(POS_FONT_SIZE), 1.0f);
         posElement->bounds.width = posSize.x;
         posElement->bounds.height = posSize.y;
 
@@ -150,27 +292,27 @@ void dataScreen::buildUI(const WordData& data) {
     auto horizontalGap = SpacerElement::createHorizontal(20.0f);
     auto verticalGap = SpacerElement::createVertical(20.0f);
 
-    auto definitionFrame = std::make_unique<Frame>(Rectangle{0, 0, screenWidth, 0}, BLANK, Padding(0.0f));
-    definitionFrame->layoutMode = Frame::Layout::Vertical;
+    // Definitions scroll in whatever is left of the screen below the header.
+    // Only the ones on screen are wrapped, updated and drawn, however many there are.
+    float definitionHeight = screenHeight - (80.0f + screenHeight / 3 - 40) - 100.0f;
+    if (!corrections.empty()) definitionHeight -= 80.0f + tailFrame->spacing;
+
+    auto definitionFrame = std::make_unique<ScrollFrame>(
+        Rectangle{0, 0, screenWidth - 160.0f, definitionHeight}, BLANK, Padding(0.0f));
+    definitionFrame->spacing = 20.0f;
+    definitionFrame->estimatedItemHeight = static_cast<float>(DEFINITION_FONT_SIZE);
 
-	int idx = 0;
     for (const auto& definitionStr : data.definitionList) {
-		auto definitionElement = std::make_unique<TextElement>(definitionStr, DEFINITION_FONT_SIZE, TEXT_PRIMARY);
-		definitionElement->font = definitionFont;
-		definitionElement->useCustomFont = true;
+        auto definitionElement = std::make_unique<TextElement>(definitionStr, DEFINITION_FONT_SIZE, TEXT_PRIMARY);
+        definitionElement->font = definitionFont;
+        definitionElement->useCustomFont = true;
 
-		Vector2 defSize = MeasureTextEx(definitionFont, definitionStr.c_str(), static_cast<float>(DEFINITION_FONT_SIZE), 1.0f);
-        definitionElement->bounds.width = defSize.x;
-        definitionElement->bounds.height = defSize.y;
+        // Wrapped by the scroll frame when it first comes into view
+        definitionElement->useWrapText = true;
+        definitionElement->wrapLength = screenWidth - 160.0f;
+        definitionElement->bounds.width = 0.0f;
 
         definitionFrame->AddChild(std::move(definitionElement));
-
-        if (idx < data.definitionList.size() - 1) {
-            auto spacer = SpacerElement::createVertical(20.0f);
-            definitionFrame->AddChild(std::move(spacer));
-        }
-
-        idx++;
     }
 
     lineFrame->AddChild(std::move(phoneticElement));
@@ -181,8 +323,59 @@ void dataScreen::buildUI(const WordData& data) {
     headFrame->AddChild(std::move(verticalGap));
     headFrame->AddChild(std::move(lineFrame));
 
+    // Sits above the definitions, the definition frame has no height of its own
+    if (!corrections.empty()) {
+        auto suggestFrame = std::make_unique<Frame>(Rectangle{0, 0, screenWidth, 80}, BLANK, Padding(0.0f, 0.0f, 30.0f, 0.0f));
+        suggestFrame->layoutMode = Frame::Layout::Horizontal;
+        suggestFrame->align = Alignment{Alignment::Horizontal::Left, Alignment::Vertical::Center};
+        suggestFrame->spacing = 15.0f;
+
+        auto prompt = std::make_unique<TextElement>("Did you mean:", DEFINITION_FONT_SIZE, TEXT_ACCENT);
+        prompt->setFont(definitionFont);
+        suggestFrame->AddChild(std::move(prompt));
+
+        for (const auto& alternative : corrections) {
+            auto altButton = ButtonElement::createAutoSize(alternative, DEFINITION_FONT_SIZE, Padding(8.0f, 16.0f),
+                [this, alternative]() {
+                    // Deferred to update(), loading now would rebuild the tree mid-iteration
+                    requestedWord = alternative;
+                });
+            altButton->font = definitionFont;
+            altButton->useCustomFont = true;
+            altButton->style.normalColor = Color{70, 35, 35, 255};
+            altButton->style.hoverColor = Color{90, 45, 45, 255};
+            altButton->style.pressedColor = Color{50, 25, 25, 255};
+            altButton->style.textNormalColor = TEXT_PRIMARY;
+            altButton->style.textHoverColor = WHITE;
+            suggestFrame->AddChild(std::move(altButton));
+        }
+
+        // The headword list can be wrong, so the word itself is one click away
+        if (!ruledOutWord.empty()) {
+            auto anywayButton = ButtonElement::createAutoSize("Search anyway", DEFINITION_FONT_SIZE,
+                Padding(8.0f, 16.0f),
+                [this]() { searchAnywayRequested = true; });
+            anywayButton->font = definitionFont;
+            anywayButton->useCustomFont = true;
+            anywayButton->style.normalColor = Color{50, 25, 25, 255};
+            anywayButton->style.hoverColor = Color{90, 45, 45, 255};
+            anywayButton->style.pressedColor = Color{50, 25, 25, 255};
+            anywayButton->style.textNormalColor = TEXT_ACCENT;
+            anywayButton->style.textHoverColor = WHITE;
+            suggestFrame->AddChild(std::move(anywayButton));
+        }
+
+        tailFrame->AddChild(std::move(suggestFrame));
+    }
+
     tailFrame->AddChild(std::move(definitionFrame));
 
+    // Nothing here changes after this point except hover states and scrolling,
+    // so each section is drawn from a texture until one of those happens
+    topBar->cacheContents = true;
+    headFrame->cacheContents = true;
+    tailFrame->cacheContents = true;
+
     rootFrame->AddChild(std::move(topBar));
     rootFrame->AddChild(std::move(headFrame));
     rootFrame->AddChild(std::move(tailFrame));
@@ -190,9 +383,33 @@ void dataScreen::buildUI(const WordData& data) {
 }
 
 void dataScreen::update() {
+    if (isLoading && pendingLookup.ready()) {
+        finishLoading();
+    }
+
     rootFrame->update({0, 0});
+
+    if (!requestedWord.empty()) {
+        std::string word = std::move(requestedWord);
+        requestedWord.clear();
+        loadWord(word);
+    }
+    else if (searchAnywayRequested) {
+        searchAnywayRequested = false;
+        std::string word = std::move(ruledOutWord);
+        ruledOutWord.clear();
+        corrections.clear();
+        startLookup(word, lookupHandle{});
+    }
 }
 
 void dataScreen::draw() {
     rootFrame->draw({0, 0});
+    rootFrame->paintDirty = false;
+}
+
+bool dataScreen::needsRedraw() const {
+    // A finished lookup wakes the loop through lookupWorker's listener and
+    // rebuilds the tree, so the pending lookup needs no polling
+    return rootFrame && rootFrame->paintDirty;
 }
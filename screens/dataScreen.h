@@ -7,6 +7,9 @@
 #include "screen.h"
 #include "ui.h"
 #include "fetcher.h"
+#include "lookupWorker.h"
+#include "headwords.h"
+#include "fontManager.h"
 
 class dataScreen : public Screen {
 public:
@@ -17,9 +20,14 @@ public:
     void onExit() override;
     void update() override;
     void draw() override;
+    bool needsRedraw() const override;
 
-    // Load new word data
-    void loadWord(const std::string& word);
+    // Load new word data. prefetched is a lookup for the same word that is
+    // already running or done, taken over instead of starting another one.
+    void loadWord(const std::string& word, lookupHandle prefetched = {});
+    // Shows data that is already at hand, without a lookup (UiBench)
+    void showWordData(const WordData& data);
+    bool isLoadingWord() const { return isLoading; }
     bool hasBackRequested() const { return shouldGoBack; }
     void resetBackRequest() { shouldGoBack = false; }
 
@@ -32,16 +40,33 @@ private:
     WordData currentWordData;
     bool shouldGoBack;
 
+    // Async lookup state
+    lookupHandle pendingLookup;
+    bool isLoading;
+
+    // "Did you mean" alternatives for a word that was not found
+    std::vector<std::string> corrections;
+    std::string requestedWord;
+
+    // Word the headword list ruled out without a lookup, for "Search anyway"
+    std::string ruledOutWord;
+    bool searchAnywayRequested = false;
+
     // Fonts
-    Font wordFont;
-    Font phoneticFont;
-    Font posFont;
-    Font definitionFont;
+    fontHandle wordFont;
+    fontHandle phoneticFont;
+    fontHandle posFont;
+    fontHandle definitionFont;
 
     // UI element pointers (for updates)
     ButtonElement* backButtonPtr;
 
     void buildUI(const WordData& data);
+    void buildLoadingUI(const std::string& word);
+    // The lookup itself, past the headword check
+    void startLookup(const std::string& word, lookupHandle prefetched);
+    void finishLoading();
+    void showResult(const WordData& data);
     void loadFonts(const WordData& data);
     void unloadFonts();
 };
@@ -10,6 +10,13 @@ public:
     virtual void update() = 0;
     virtual void draw() = 0;
     virtual void handleInput() {}
+
+    // Event-driven rendering. needsRedraw() asks whether the last update()
+    // changed anything on screen. nextWakeup() is how many seconds from now
+    // the screen changes by itself (a blinking caret), 0 while it animates,
+    // or negative when only input or finished background work can change it.
+    virtual bool needsRedraw() const { return true; }
+    virtual double nextWakeup() const { return -1.0; }
 };
 
 #endif // SCREEN_H
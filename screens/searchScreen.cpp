@@ -1,4 +1,8 @@
 #include "searchScreen.h"
+#include "fetcher.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 // Font Sizes
@@ -6,6 +10,14 @@ constexpr int TITLE_SIZE = 72;
 constexpr int INPUT_SIZE = 48; 
 constexpr int SUBTITLE_SIZE = 24;
 constexpr int BUTTON_SIZE = 32;
+constexpr int SUGGESTION_SIZE = 32;
+
+// Autocomplete dropdown
+constexpr size_t MAX_SUGGESTIONS = 6;
+constexpr float SUGGESTION_ROW_HEIGHT = 48.0f;
+
+// Caret is shown for this long, then hidden for as long
+constexpr double CURSOR_BLINK_SECONDS = 0.5;
 
 // Font paths
 static const char *FONT_BYTESIZED5 = "D:/fonts/Bytesized/Bytesized-Regular.ttf";
@@ -18,48 +30,63 @@ constexpr Color BG_HEADER = Color{45, 20, 20, 255};
 constexpr Color TEXT_PRIMARY = Color{240, 200, 200, 255};
 constexpr Color TEXT_ACCENT = Color{220, 120, 120, 255};
 constexpr Color INPUT_BG = Color{50, 25, 25, 255};
+constexpr Color SUGGESTION_BG = Color{60, 30, 30, 255};
+constexpr Color SUGGESTION_SELECTED_BG = Color{110, 55, 55, 255};
 
 searchScreen::searchScreen(float screenWidth, float screenHeight)
     : screenWidth(screenWidth), screenHeight(screenHeight),
-      isInputActive(true), shouldNavigate(false), cursorPosition(0), cursorBlinkTimer(0.0f), showCursor(true) {}
+      isInputActive(true), shouldNavigate(false), cursorPosition(0), cursorBlinkStart(0.0), showCursor(true),
+      overlayDirty(true), suggestionsIndex(nullptr), selectedSuggestion(-1), pointerOnSuggestions(false),
+      prefetcher(lookupWorker::instance()) {
+    // A word a complete headword list already rules out is not worth a request
+    prefetcher.setFilter([](const std::string& word) { return !headwordIndex::instance().isKnownMisspelling(word); });
+}
 
 void searchScreen::onEnter() {
     searchQuery = "";
     isInputActive = true;
     shouldNavigate = false;
     cursorPosition = 0;
+    cursorBlinkStart = Input::time();
+    overlayDirty = true;
+
+    suggestions.clear();
+    suggestionsFor.clear();
+    suggestionsIndex = nullptr;
+    selectedSuggestion = -1;
 
     loadFonts();
     buildUI();
 }
 
 void searchScreen::onExit() {
+    // Whatever was not taken by the data screen is no longer wanted
+    prefetcher.cancel();
+
     rootFrame.reset();
+    suggestionFrame.reset();
     unloadFonts();
 }
 
 void searchScreen::loadFonts() {
-    titleFont = LoadFontEx(FONT_BYTESIZED5, TITLE_SIZE, nullptr, 0);
-    SetTextureFilter(titleFont.texture, TEXTURE_FILTER_POINT);
-
-    inputFont = LoadFontEx(FONT_NOTO_SANS, INPUT_SIZE, nullptr, 0);
-    SetTextureFilter(inputFont.texture, TEXTURE_FILTER_POINT);
-
-    subtitleFont = LoadFontEx(FONT_MERRIWEATHER, SUBTITLE_SIZE, nullptr, 0);
-    SetTextureFilter(subtitleFont.texture, TEXTURE_FILTER_POINT);
-    
-    buttonFont = LoadFontEx(FONT_BUTTON, BUTTON_SIZE, nullptr, 0);
-    SetTextureFilter(buttonFont.texture, TEXTURE_FILTER_POINT);
+    PROFILE_SCOPE("searchScreen::loadFonts");
+    // Shared with dataScreen, so coming back from a lookup reuses the loaded atlases
+    fontManager& fonts = fontManager::instance();
+    titleFont = fonts.acquire(FONT_BYTESIZED5, TITLE_SIZE);
+    inputFont = fonts.acquire(FONT_NOTO_SANS, INPUT_SIZE);
+    subtitleFont = fonts.acquireDynamic(FONT_MERRIWEATHER, SUBTITLE_SIZE);
+    buttonFont = fonts.acquire(FONT_BUTTON, BUTTON_SIZE);
 }
 
 void searchScreen::unloadFonts() {
-    UnloadFont(titleFont);
-    UnloadFont(inputFont);
-    UnloadFont(subtitleFont);
-    UnloadFont(buttonFont);
+    titleFont.reset();
+    inputFont.reset();
+    subtitleFont.reset();
+    buttonFont.reset();
 }
 
 void searchScreen::buildUI() {
+    PROFILE_SCOPE("searchScreen::buildUI");
     rootFrame = std::make_unique<Frame>(
         Rectangle{0, 0, screenWidth, screenHeight},
         BG_HEADER,
@@ -81,14 +108,14 @@ void searchScreen::buildUI() {
     auto title = std::make_unique<TextElement>("Dictionary", TITLE_SIZE, TEXT_PRIMARY);
     title->font = titleFont;
     title->useCustomFont = true;
-    Vector2 titleSize = MeasureTextEx(titleFont, "Dictionary", TITLE_SIZE, 1.0f);
+    Vector2 titleSize = TextMeasure::measure(titleFont, "Dictionary", TITLE_SIZE, 1.0f);
     title->bounds.width = titleSize.x;
     title->bounds.height = titleSize.y;
 
     auto subtitle = std::make_unique<TextElement>("Dictionary", SUBTITLE_SIZE, TEXT_PRIMARY);
     subtitle->font = subtitleFont;
     subtitle->useCustomFont = true;
-    Vector2 subtitleSize = MeasureTextEx(titleFont, "Dictionary", SUBTITLE_SIZE, 1.0f);
+    Vector2 subtitleSize = TextMeasure::measure(titleFont, "Dictionary", SUBTITLE_SIZE, 1.0f);
     subtitle->bounds.width = subtitleSize.x;
     subtitle->bounds.height = subtitleSize.y;
 
@@ -138,26 +165,137 @@ void searchScreen::buildUI() {
     contentFrame->AddChild(SpacerElement::createVertical(10.0f));
     contentFrame->AddChild(std::move(searchButton));
     
+    // Repainted only when the query changes or the button changes state
+    contentFrame->cacheContents = true;
+
     rootFrame->AddChild(std::move(contentFrame));
 }
 
+void searchScreen::updateSuggestions() {
+    // Only re-query when the text changed or the background index just became ready
+    std::shared_ptr<const prefixIndex> index = headwordIndex::instance().prefixes();
+    std::string prefix = normalizeWord(searchQuery);
+
+    if (prefix == suggestionsFor && index.get() == suggestionsIndex) return;
+    PROFILE_SCOPE("searchScreen::updateSuggestions");
+
+    suggestionsFor = prefix;
+    suggestionsIndex = index.get();
+    selectedSuggestion = -1;
+
+    suggestions.clear();
+    if (index && !prefix.empty()) {
+        suggestions = index->complete(prefix, MAX_SUGGESTIONS);
+
+        // Nothing to suggest when the only completion is what was typed
+        if (suggestions.size() == 1 && suggestions[0] == prefix) suggestions.clear();
+    }
+
+    buildSuggestionUI();
+}
+
+Rectangle searchScreen::suggestionArea() const {
+    // drawArea is the input frame's padded content area from the last layout pass
+    Rectangle input = {
+        inputFramePtr->drawArea.x - inputFramePtr->padding.left,
+        inputFramePtr->drawArea.y - inputFramePtr->padding.top,
+        inputFramePtr->bounds.width,
+        inputFramePtr->bounds.height
+    };
+
+    return Rectangle{
+        input.x,
+        input.y + input.height,
+        input.width,
+        SUGGESTION_ROW_HEIGHT * static_cast<float>(suggestions.size())
+    };
+}
+
+void searchScreen::buildSuggestionUI() {
+    overlayDirty = true;
+
+    if (suggestions.empty()) {
+        suggestionFrame.reset();
+        return;
+    }
+
+    suggestionFrame = std::make_unique<Frame>(
+        Rectangle{0, 0, inputFramePtr->bounds.width, SUGGESTION_ROW_HEIGHT * static_cast<float>(suggestions.size())},
+        SUGGESTION_BG,
+        Padding(0.0f)
+    );
+    suggestionFrame->layoutMode = Frame::Layout::Vertical;
+    suggestionFrame->spacing = 0.0f;
+
+    for (size_t i = 0; i < suggestions.size(); ++i) {
+        bool selected = static_cast<int>(i) == selectedSuggestion;
+
+        auto row = std::make_unique<Frame>(
+            Rectangle{0, 0, inputFramePtr->bounds.width, SUGGESTION_ROW_HEIGHT},
+            selected ? SUGGESTION_SELECTED_BG : SUGGESTION_BG,
+            Padding(0.0f, 20.0f)
+        );
+        row->layoutMode = Frame::Layout::Horizontal;
+        row->align = {Alignment::Horizontal::Left, Alignment::Vertical::Center};
+
+        auto label = std::make_unique<TextElement>(suggestions[i], SUGGESTION_SIZE, selected ? WHITE : TEXT_PRIMARY);
+        label->setFont(inputFont);
+        row->AddChild(std::move(label));
+
+        suggestionFrame->AddChild(std::move(row));
+    }
+}
+
 void searchScreen::handleInput() {
-    int key = GetCharPressed();
+    int key = Input::charPressed();
     
     while (key > 0) {
         if ((key >= 32) && (key <= 125)) {
             searchQuery += static_cast<char>(key);
             cursorPosition++;
         }
-        key = GetCharPressed();
+        key = Input::charPressed();
     }
 
-    if (IsKeyPressed(KEY_BACKSPACE) && !searchQuery.empty()) {
+    if (Input::keyPressed(KEY_BACKSPACE) && !searchQuery.empty()) {
         searchQuery.pop_back();
         if (cursorPosition > 0) cursorPosition--;
     }
 
-    if (IsKeyPressed(KEY_ENTER) && !searchQuery.empty()) {
+    pointerOnSuggestions = false;
+
+    // Arrow keys walk the dropdown, Enter picks the highlighted suggestion
+    if (!suggestions.empty()) {
+        int count = static_cast<int>(suggestions.size());
+        int selection = selectedSuggestion;
+
+        if (Input::keyPressed(KEY_DOWN)) selection = (selection + 1) % count;
+        if (Input::keyPressed(KEY_UP)) selection = selection <= 0 ? count - 1 : selection - 1;
+
+        Rectangle area = suggestionArea();
+        Vector2 mouse = Input::mousePosition();
+        bool mouseOver = CheckCollisionPointRec(mouse, area);
+        pointerOnSuggestions = mouseOver;
+        bool clicked = mouseOver && Input::mouseButtonPressed(MOUSE_LEFT_BUTTON);
+        bool mouseMoved = Input::mouseDelta().x != 0.0f || Input::mouseDelta().y != 0.0f;
+        if (mouseOver && (mouseMoved || clicked)) {
+            selection = static_cast<int>((mouse.y - area.y) / SUGGESTION_ROW_HEIGHT);
+        }
+
+        if (selection != selectedSuggestion) {
+            selectedSuggestion = std::clamp(selection, 0, count - 1);
+            buildSuggestionUI();
+        }
+
+        if ((Input::keyPressed(KEY_ENTER) || clicked) && selectedSuggestion >= 0) {
+            searchQuery = suggestions[selectedSuggestion];
+            cursorPosition = static_cast<int>(searchQuery.size());
+            shouldNavigate = true;
+            std::cout << "Searching for: " << searchQuery << "\n";
+        }
+    }
+
+    if (Input::keyPressed(KEY_ENTER) && !searchQuery.empty() && !shouldNavigate) {
         shouldNavigate = true;
         std::cout << "Searching for: " << searchQuery << "\n";
     }
@@ -166,30 +304,66 @@ void searchScreen::handleInput() {
         inputTextPtr->setText(searchQuery.empty() ? "" : searchQuery);
     }
 
-    
+    updateSuggestions();
 }
 
 void searchScreen::update() {
+    std::string previousQuery = searchQuery;
     handleInput();
-    
-    cursorBlinkTimer += GetFrameTime();
-    if (cursorBlinkTimer >= 0.5f) {
-        showCursor = !showCursor;
-        cursorBlinkTimer = 0.0f;
+
+    // Typing keeps the caret solid; it starts blinking again from the last edit
+    if (searchQuery != previousQuery) cursorBlinkStart = Input::time();
+
+    double sinceEdit = Input::time() - cursorBlinkStart;
+    bool cursorOn = std::fmod(sinceEdit, 2.0 * CURSOR_BLINK_SECONDS) < CURSOR_BLINK_SECONDS;
+    if (cursorOn != showCursor) {
+        showCursor = cursorOn;
+        overlayDirty = true;
     }
 
-    rootFrame->update({0, 0});
+    // Enter on a highlighted suggestion looks that up, so it is the better guess
+    const std::string& candidate = selectedSuggestion >= 0 ? suggestions[selectedSuggestion] : searchQuery;
+    prefetcher.update(candidate, Input::time());
+
+    // Whatever lies under the dropdown must not see the click that picked a suggestion
+    if (!pointerOnSuggestions) rootFrame->update({0, 0});
+}
+
+bool searchScreen::needsRedraw() const {
+    return overlayDirty || (rootFrame && rootFrame->paintDirty) || (suggestionFrame && suggestionFrame->paintDirty);
+}
+
+double searchScreen::nextWakeup() const {
+    if (!isInputActive) return -1.0;
+
+    // Next caret toggle, or the prefetch coming due if that is sooner
+    double sinceEdit = Input::time() - cursorBlinkStart;
+    double wakeup = CURSOR_BLINK_SECONDS - std::fmod(sinceEdit, CURSOR_BLINK_SECONDS);
+
+    double prefetchDue = prefetcher.secondsUntilDue(Input::time());
+    if (prefetchDue >= 0.0) wakeup = std::min(wakeup, prefetchDue);
+    return wakeup;
 }
 
 void searchScreen::draw() {
     rootFrame->draw({0, 0});
 
+    // Dropdown overlaps whatever sits under the input box
+    if (suggestionFrame) {
+        Rectangle area = suggestionArea();
+        suggestionFrame->draw({area.x, area.y});
+    }
+
     if (isInputActive && showCursor && inputTextPtr) {
-        Vector2 textSize = MeasureTextEx(inputFont, searchQuery.c_str(), static_cast<float>(INPUT_SIZE), 1.0f);
+        Vector2 textSize = TextMeasure::measure(inputFont, searchQuery.c_str(), static_cast<float>(INPUT_SIZE), 1.0f);
         
                 float cursorX = 500 + textSize.x + 20;
                 float cursorY = 215;
         
         DrawRectangle(static_cast<int>(cursorX), static_cast<int>(cursorY), 2, INPUT_SIZE, TEXT_PRIMARY);
     }
+
+    rootFrame->paintDirty = false;
+    if (suggestionFrame) suggestionFrame->paintDirty = false;
+    overlayDirty = false;
 }
@@ -3,9 +3,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <raylib.h>
 #include "screen.h"
 #include "ui.h"
+#include "headwords.h"
+#include "fontManager.h"
+#include "lookupPrefetcher.h"
 
 class searchScreen : public Screen {
 public:
@@ -17,12 +21,19 @@ public:
     void update() override;
     void draw() override;
     void handleInput() override;
+    bool needsRedraw() const override;
+    double nextWakeup() const override;
 
     // Get the searched word
     std::string getSearchedWord() const { return searchQuery; }
     bool hasSearched() const { return shouldNavigate; }
     void resetSearch() { shouldNavigate = false; }
 
+    // Lookup already started for word while it was being typed, if any
+    lookupHandle takePrefetch(const std::string& word) { return prefetcher.take(word); }
+    [[nodiscard]] const lookupPrefetcherStats& prefetchStats() const { return prefetcher.stats(); }
+    void setPrefetchDebounce(std::chrono::milliseconds interval) { prefetcher.setDebounce(interval); }
+
 private:
     float screenWidth;
     float screenHeight;
@@ -33,20 +44,40 @@ private:
     bool isInputActive;
     bool shouldNavigate;
     int cursorPosition;
-    float cursorBlinkTimer;
+    double cursorBlinkStart;  // Input::time() of the last edit, the caret blinks from there
     bool showCursor;
 
+    // Caret or dropdown changed since the last draw; neither is in rootFrame
+    bool overlayDirty;
+
+    // Autocomplete state
+    std::vector<std::string> suggestions;
+    std::string suggestionsFor;
+    const prefixIndex* suggestionsIndex;
+    int selectedSuggestion;
+    std::unique_ptr<Frame> suggestionFrame;
+
+    // The dropdown covers part of rootFrame (the Search button); while the
+    // pointer is on it, clicks and hover belong to the dropdown alone
+    bool pointerOnSuggestions;
+
+    // Speculative lookup of the query (or highlighted suggestion) once typing pauses
+    lookupPrefetcher prefetcher;
+
     // Fonts
-    Font titleFont;
-    Font inputFont;
-    Font subtitleFont;
-    Font buttonFont;
+    fontHandle titleFont;
+    fontHandle inputFont;
+    fontHandle subtitleFont;
+    fontHandle buttonFont;
 
     // UI element pointers (for updates)
     TextElement* inputTextPtr;
     Frame* inputFramePtr;
 
     void buildUI();
+    void updateSuggestions();
+    void buildSuggestionUI();
+    [[nodiscard]] Rectangle suggestionArea() const;
     void loadFonts();
     void unloadFonts();
 };
@@ -2,9 +2,14 @@
 // Created by SAGNIK on 30-09-2025.
 //
 
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "fetcher.h"
 #include "screenManager.h"
 
-int main() {
+int main(int argc, char** argv) {
     // Screen dimensions
     const float SCREEN_WIDTH = 1920.0f;
     const float SCREEN_HEIGHT = 1080.0f;
@@ -12,6 +17,41 @@ int main() {
     // Create the screen manager
     screenManager manager(SCREEN_WIDTH, SCREEN_HEIGHT);
 
+    // --continuous redraws every frame instead of sleeping while idle
+    // --prefetch-ms N sets the typing pause before a lookup is prefetched (0 = off)
+    // --record FILE writes every frame's input to FILE
+    // --replay FILE plays FILE back with canned lookups and reports frame times;
+    //   --report FILE saves that report as JSON, --replay-latency-ms N delays each lookup
+    // --base-url URL looks words up somewhere other than dictionaryapi.dev
+    std::string recordPath;
+    std::string replayPath;
+    std::string reportPath;
+    int replayLatencyMs = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--continuous") == 0) manager.setEventDriven(false);
+        else if (std::strcmp(argv[i], "--prefetch-ms") == 0 && hasValue) {
+            manager.setPrefetchDebounce(std::chrono::milliseconds(std::atoi(argv[++i])));
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && hasValue) recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && hasValue) replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--report") == 0 && hasValue) reportPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay-latency-ms") == 0 && hasValue) replayLatencyMs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--base-url") == 0 && hasValue) setApiBaseUrl(argv[++i]);
+    }
+
+    if (!replayPath.empty()) {
+        if (!manager.replayInputFrom(replayPath, reportPath, std::chrono::milliseconds(replayLatencyMs))) {
+            std::cerr << "Cannot replay " << replayPath << ": " << manager.replayError() << "\n";
+            return 1;
+        }
+    }
+    else if (!recordPath.empty() && !manager.recordInputTo(recordPath)) {
+        std::cerr << "Cannot record to " << recordPath << "\n";
+        return 1;
+    }
+
     // Initialize (creates window, loads screens)
     manager.initialize();
 
@@ -0,0 +1,177 @@
+//
+// Headless batch lookups: one word per line in, one NDJSON WordData per line out.
+//
+// Usage: DictionaryBatch [-j jobs] [--unordered] [--base-url URL] [--cache-dir DIR] [--no-hedge] [words.txt]
+//
+//   -j N             number of lookups in flight at once (default 8)
+//   --unordered      write results as they complete instead of in input order
+//   --base-url URL   API to look words up in, e.g. a MockDictionaryServer at
+//                    http://127.0.0.1:8089/api/v2/entries/en/
+//   --cache-dir DIR  disk cache directory, so a load test starts cold and
+//                    leaves the app's cache alone
+//   --no-hedge       never send a second copy of a slow request, to compare tail latency
+//
+// Reads stdin when no file is given. A throughput and latency summary goes to stderr.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fetcher.h"
+#include "diskCache.h"
+#include "hedgedClient.h"
+#include "wordCache.h"
+
+using batchClock = std::chrono::steady_clock;
+
+static std::string toNdjson(const std::string& query, const WordData& data, double latencyMs) {
+    nlohmann::json line = {
+        {"query", query},
+        {"found", data.word != "Not Found"},
+        {"word", data.word},
+        {"phonetic", data.phonetic},
+        {"partsOfSpeech", data.posList},
+        {"definitions", data.definitionList},
+        {"latencyMs", latencyMs}
+    };
+    // Definitions from the API are not guaranteed to be valid UTF-8
+    return line.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+static double percentile(std::vector<double> sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    std::sort(sorted.begin(), sorted.end());
+    size_t rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+int main(int argc, char** argv) {
+    size_t jobs = 8;
+    bool ordered = true;
+    std::string inputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            jobs = std::max<size_t>(1, std::stoul(argv[++i]));
+        }
+        else if (arg == "--unordered") {
+            ordered = false;
+        }
+        else if (arg == "--base-url" && i + 1 < argc) {
+            setApiBaseUrl(argv[++i]);
+        }
+        else if (arg == "--cache-dir" && i + 1 < argc) {
+            diskCache::configure(argv[++i]);
+        }
+        else if (arg == "--no-hedge") {
+            hedgedClient::instance().setHedging(false);
+        }
+        else if (arg == "-h" || arg == "--help") {
+            std::cerr << "Usage: " << argv[0]
+                      << " [-j jobs] [--unordered] [--base-url URL] [--cache-dir DIR] [--no-hedge] [words.txt]\n";
+            return 0;
+        }
+        else {
+            inputPath = arg;
+        }
+    }
+
+    std::ifstream file;
+    if (!inputPath.empty()) {
+        file.open(inputPath);
+        if (!file) {
+            std::cerr << "Cannot open " << inputPath << "\n";
+            return 1;
+        }
+    }
+    std::istream& input = inputPath.empty() ? std::cin : file;
+
+    std::vector<std::string> words;
+    std::string line;
+    while (std::getline(input, line)) {
+        if (!normalizeWord(line).empty()) words.push_back(line);
+    }
+
+    std::vector<std::optional<std::string>> results(words.size());
+    std::vector<double> latencies(words.size(), 0.0);
+    std::atomic<size_t> nextWord{0};
+    std::atomic<size_t> notFound{0};
+
+    std::mutex outputMutex;
+    std::condition_variable resultReady;
+    size_t nextToWrite = 0;
+
+    auto start = batchClock::now();
+
+    auto worker = [&]() {
+        for (size_t i = nextWord++; i < words.size(); i = nextWord++) {
+            auto lookupStart = batchClock::now();
+            WordData data = fetchWordData(words[i]);
+            double ms = std::chrono::duration<double, std::milli>(batchClock::now() - lookupStart).count();
+
+            latencies[i] = ms;
+            if (data.word == "Not Found") notFound++;
+            std::string json = toNdjson(words[i], data, ms);
+
+            std::lock_guard<std::mutex> lock(outputMutex);
+            if (ordered) {
+                results[i] = std::move(json);
+                resultReady.notify_one();
+            }
+            else {
+                std::cout << json << '\n';
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < std::min(jobs, std::max<size_t>(words.size(), 1)); ++t) {
+        threads.emplace_back(worker);
+    }
+
+    // Input order: the main thread drains results as soon as the next one in line is done
+    if (ordered) {
+        std::unique_lock<std::mutex> lock(outputMutex);
+        while (nextToWrite < words.size()) {
+            resultReady.wait(lock, [&]() { return results[nextToWrite].has_value(); });
+            while (nextToWrite < words.size() && results[nextToWrite]) {
+                std::cout << *results[nextToWrite] << '\n';
+                results[nextToWrite].reset();
+                nextToWrite++;
+            }
+        }
+    }
+
+    for (auto& thread : threads) thread.join();
+    hedgedClient::shutdown();
+    std::cout.flush();
+
+    double seconds = std::chrono::duration<double>(batchClock::now() - start).count();
+    wordCacheStats memory = wordCache::instance().stats();
+    diskCacheStats disk = diskCache::instance().stats();
+    singleFlightStats flights = coalescingStats();
+    hedgedClientStats network = hedgedClient::instance().stats();
+
+    std::cerr << words.size() << " lookups in " << seconds << " s ("
+              << (seconds > 0 ? static_cast<double>(words.size()) / seconds : 0.0) << " lookups/s, "
+              << jobs << " in flight)\n"
+              << "latency p50 " << percentile(latencies, 0.50) << " ms, p99 " << percentile(latencies, 0.99)
+              << " ms, max " << percentile(latencies, 1.0) << " ms\n"
+              << "not found " << notFound.load() << ", memory cache hits " << memory.hits
+              << ", disk cache hits " << disk.hits << ", duplicates coalesced " << flights.coalesced << "\n"
+              << "network requests " << network.requests << " (" << network.attempts << " sent), hedged "
+              << network.hedges << " (" << network.hedgeWins << " won, " << network.hedgesDenied
+              << " over budget), retries " << network.retries << ", timeouts " << network.timeouts << "\n"
+              << "hedging after " << network.hedgeAfterMs << " ms, timing out after " << network.timeoutMs << " ms\n";
+    return 0;
+}
@@ -0,0 +1,47 @@
+//
+// Compiles a local dictionary dump into the read-only lexicon served by the offline tier.
+//
+// Usage: LexiconImport <dump.json | dump.ndjson> [output.lex]
+//
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+#include "lexicon.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <dump.json | dump.ndjson> [output.lex]\n";
+        return 1;
+    }
+
+    std::string dumpPath = argv[1];
+    std::string outputPath = argc > 2 ? argv[2] : "dictionary.lex";
+
+    auto start = std::chrono::steady_clock::now();
+
+    lexiconBuilder builder;
+    long long seen = builder.importDump(dumpPath);
+    if (seen < 0) {
+        std::cerr << "Cannot read " << dumpPath << "\n";
+        return 1;
+    }
+
+    if (!builder.write(outputPath)) {
+        std::cerr << "Cannot write " << outputPath << "\n";
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::error_code error;
+    auto bytes = std::filesystem::file_size(outputPath, error);
+
+    // Entries without a headword, or too big for the format, are neither
+    long long rejected = seen - static_cast<long long>(builder.size() + builder.duplicates());
+
+    std::cout << "Imported " << builder.size() << " headwords (" << builder.duplicates()
+              << " duplicate entries skipped, " << rejected << " rejected) into " << outputPath << ", "
+              << bytes / 1024 << " KiB in " << seconds << " s\n";
+    return 0;
+}
@@ -0,0 +1,350 @@
+//
+// Local stand-in for dictionaryapi.dev, for testing and load-testing the fetcher
+// without the public API. Serves recorded responses over plain HTTP/1.1 with
+// keep-alive:
+//
+//   GET /api/v2/entries/en/<word>   fixtures/<word>.json, or a 404 with notfound.json
+//
+// Usage: MockDictionaryServer [--port 8089] [--fixtures dir] [--latency-ms 0] [--jitter-ms 0]
+//                             [--slow-rate 0] [--slow-ms 1000] [--error-rate 0] [--error-status 503]
+//                             [--synthesize N] [--seed 1]
+//
+//   --latency-ms N     wait N ms before every response
+//   --jitter-ms N      plus a uniformly random 0..N ms
+//   --slow-rate P      make a fraction P of requests wait --slow-ms longer, for
+//                      the heavy tail a real server has and jitter alone does not
+//   --error-rate P     answer a fraction P of requests with --error-status instead
+//   --synthesize N     answer words without a fixture with a generated entry of
+//                      N definitions instead of a 404 (large payloads, or endless
+//                      distinct words that get past every cache)
+//   --port 0           picks a free port; the one in use is printed either way
+//
+// Point the fetcher at it with DictionaryBatch --base-url http://127.0.0.1:8089/api/v2/entries/en/
+// A request count goes to stderr every second while requests are coming in.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using socketHandle = SOCKET;
+static void closeSocket(socketHandle s) { closesocket(s); }
+#else
+#include <csignal>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using socketHandle = int;
+constexpr socketHandle INVALID_SOCKET = -1;
+static void closeSocket(socketHandle s) { close(s); }
+#endif
+
+#ifndef DICTIONARY_FIXTURES_DIR
+#define DICTIONARY_FIXTURES_DIR "fixtures/responses"
+#endif
+
+constexpr const char* ROUTE = "/api/v2/entries/en/";
+constexpr size_t MAX_REQUEST_BYTES = 64 * 1024;
+
+struct serverOptions {
+    int port = 8089;
+    std::string fixtures = DICTIONARY_FIXTURES_DIR;
+    int latencyMs = 0;
+    int jitterMs = 0;
+    double slowRate = 0.0;
+    int slowMs = 1000;
+    double errorRate = 0.0;
+    int errorStatus = 503;
+    size_t synthesize = 0;
+    unsigned seed = 1;
+};
+
+struct response {
+    int status = 200;
+    std::string body;
+};
+
+static serverOptions options;
+static std::map<std::string, std::string> fixtures; // word -> response body, read-only once serving
+static std::string notFoundBody;
+static std::string syntheticMeanings; // the word-independent part of a synthesized entry
+
+static std::atomic<uint64_t> requestsServed{0};
+static std::atomic<uint64_t> errorsInjected{0};
+static std::atomic<uint64_t> slowInjected{0};
+static std::atomic<unsigned> connectionCount{0};
+
+static std::string readFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+static bool loadFixtures(const std::string& directory) {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.path().extension() != ".json") continue;
+        std::string word = entry.path().stem().string();
+        if (word == "notfound") notFoundBody = readFile(entry.path());
+        else fixtures[word] = readFile(entry.path());
+    }
+    if (error) {
+        std::cerr << "Cannot read fixtures from " << directory << ": " << error.message() << "\n";
+        return false;
+    }
+    if (notFoundBody.empty()) {
+        notFoundBody = R"({"title":"No Definitions Found","message":"","resolution":""})";
+    }
+    return true;
+}
+
+// Same shape as a real response: one entry, definitions spread over a few parts of speech
+static std::string buildSyntheticMeanings(size_t definitions) {
+    static const char* PARTS_OF_SPEECH[] = {"noun", "verb", "adjective", "adverb"};
+    nlohmann::json meanings = nlohmann::json::array();
+    size_t perMeaning = (definitions + 3) / 4;
+
+    for (size_t first = 0; first < definitions; first += perMeaning) {
+        nlohmann::json list = nlohmann::json::array();
+        for (size_t i = first; i < std::min(definitions, first + perMeaning); ++i) {
+            list.push_back({
+                {"definition", "Synthetic definition " + std::to_string(i + 1) +
+                               ", long enough to wrap onto a second line in the data screen like a real one does."},
+                {"synonyms", nlohmann::json::array()},
+                {"antonyms", nlohmann::json::array()}
+            });
+        }
+        meanings.push_back({{"partOfSpeech", PARTS_OF_SPEECH[meanings.size() % 4]}, {"definitions", list}});
+    }
+    return meanings.dump();
+}
+
+static std::string percentDecode(const std::string& text) {
+    std::string decoded;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '%' && i + 2 < text.size() && std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+            decoded += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        }
+        else {
+            decoded += text[i];
+        }
+    }
+    return decoded;
+}
+
+static std::mt19937& threadRng() {
+    thread_local std::mt19937 rng(options.seed + connectionCount.load());
+    return rng;
+}
+
+static response route(const std::string& path) {
+    // Faults first, so they land on every kind of request alike
+    if (options.latencyMs > 0 || options.jitterMs > 0 || options.slowRate > 0.0) {
+        int ms = options.latencyMs;
+        if (options.jitterMs > 0) ms += std::uniform_int_distribution<int>(0, options.jitterMs)(threadRng());
+        if (options.slowRate > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(threadRng()) < options.slowRate) {
+            slowInjected++;
+            ms += options.slowMs;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+    if (options.errorRate > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(threadRng()) < options.errorRate) {
+        errorsInjected++;
+        return {options.errorStatus, R"({"title":"Injected error"})"};
+    }
+
+    if (path.rfind(ROUTE, 0) != 0) return {404, notFoundBody};
+
+    std::string word = percentDecode(path.substr(std::strlen(ROUTE)));
+    std::transform(word.begin(), word.end(), word.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    auto fixture = fixtures.find(word);
+    if (fixture != fixtures.end()) return {200, fixture->second};
+
+    if (options.synthesize > 0 && !word.empty()) {
+        nlohmann::json name = word;
+        std::string body = "[{\"word\":" + name.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) +
+                           ",\"phonetic\":\"/mock/\",\"meanings\":" + syntheticMeanings + "}]";
+        return {200, std::move(body)};
+    }
+    return {404, notFoundBody};
+}
+
+static const char* reason(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 404: return "Not Found";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
+        default: return "Error";
+    }
+}
+
+static bool sendAll(socketHandle s, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        auto n = send(s, data.data() + sent, static_cast<int>(data.size() - sent), 0);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+static std::string lowercase(std::string text) {
+    for (char& c : text) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return text;
+}
+
+// One client connection: requests are answered in order until either side closes
+static void serveConnection(socketHandle client) {
+    std::string buffer;
+    char chunk[16 * 1024];
+
+    while (true) {
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (buffer.size() > MAX_REQUEST_BYTES) {
+                closeSocket(client);
+                return;
+            }
+            auto n = recv(client, chunk, static_cast<int>(sizeof(chunk)), 0);
+            if (n <= 0) {
+                closeSocket(client);
+                return;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+
+        std::string head = lowercase(buffer.substr(0, headerEnd));
+        std::istringstream requestLine(buffer.substr(0, buffer.find("\r\n")));
+        std::string method, target, version;
+        requestLine >> method >> target >> version;
+
+        // GET has no body, but skip one if a client sends it anyway
+        size_t consumed = headerEnd + 4;
+        size_t lengthAt = head.find("\r\ncontent-length:");
+        if (lengthAt != std::string::npos) {
+            consumed += std::strtoul(head.c_str() + lengthAt + 17, nullptr, 10);
+        }
+        bool keepAlive = version == "HTTP/1.1" ? head.find("\r\nconnection: close") == std::string::npos
+                                               : head.find("\r\nconnection: keep-alive") != std::string::npos;
+
+        response r = method == "GET" ? route(target) : response{405, R"({"title":"Method Not Allowed"})"};
+        requestsServed++;
+
+        std::string reply = "HTTP/1.1 " + std::to_string(r.status) + " " + reason(r.status) +
+                            "\r\nContent-Type: application/json\r\nContent-Length: " +
+                            std::to_string(r.body.size()) +
+                            (keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n") +
+                            r.body;
+        if (!sendAll(client, reply) || !keepAlive) break;
+
+        buffer.erase(0, std::min(consumed, buffer.size()));
+    }
+    closeSocket(client);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--port" && hasValue) options.port = std::stoi(argv[++i]);
+        else if (arg == "--fixtures" && hasValue) options.fixtures = argv[++i];
+        else if (arg == "--latency-ms" && hasValue) options.latencyMs = std::max(0, std::stoi(argv[++i]));
+        else if (arg == "--jitter-ms" && hasValue) options.jitterMs = std::max(0, std::stoi(argv[++i]));
+        else if (arg == "--slow-rate" && hasValue) options.slowRate = std::stod(argv[++i]);
+        else if (arg == "--slow-ms" && hasValue) options.slowMs = std::max(0, std::stoi(argv[++i]));
+        else if (arg == "--error-rate" && hasValue) options.errorRate = std::stod(argv[++i]);
+        else if (arg == "--error-status" && hasValue) options.errorStatus = std::stoi(argv[++i]);
+        else if (arg == "--synthesize" && hasValue) options.synthesize = std::stoul(argv[++i]);
+        else if (arg == "--seed" && hasValue) options.seed = static_cast<unsigned>(std::stoul(argv[++i]));
+        else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--port 8089] [--fixtures dir] [--latency-ms 0] [--jitter-ms 0]"
+                         " [--slow-rate 0] [--slow-ms 1000] [--error-rate 0] [--error-status 503]"
+                         " [--synthesize N] [--seed 1]\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (!loadFixtures(options.fixtures)) return 1;
+    if (options.synthesize > 0) syntheticMeanings = buildSyntheticMeanings(options.synthesize);
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#else
+    // A client hanging up mid-response is an error from send(), not a reason to exit
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    socketHandle listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET) {
+        std::cerr << "Cannot create a socket\n";
+        return 1;
+    }
+    int yes = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&yes),
+               static_cast<socklen_t>(sizeof(yes)));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(options.port));
+    auto addressLength = static_cast<socklen_t>(sizeof(address));
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), addressLength) != 0 || listen(listener, 512) != 0) {
+        std::cerr << "Cannot listen on 127.0.0.1:" << options.port << "\n";
+        closeSocket(listener);
+        return 1;
+    }
+
+    getsockname(listener, reinterpret_cast<sockaddr*>(&address), &addressLength);
+    std::cout << "Serving " << fixtures.size() << " fixtures from " << options.fixtures << " on http://127.0.0.1:"
+              << ntohs(address.sin_port) << ROUTE << std::endl;
+
+    std::thread([]() {
+        uint64_t last = 0;
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            uint64_t served = requestsServed.load();
+            if (served == last) continue;
+            std::cerr << served - last << " requests/s, " << served << " total, " << errorsInjected.load()
+                      << " errors and " << slowInjected.load() << " slow responses injected\n";
+            last = served;
+        }
+    }).detach();
+
+    while (true) {
+        socketHandle client = accept(listener, nullptr, nullptr);
+        if (client == INVALID_SOCKET) continue;
+
+        // Small responses on a kept-alive connection must not wait for Nagle
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&yes),
+               static_cast<socklen_t>(sizeof(yes)));
+        connectionCount++;
+        std::thread(serveConnection, client).detach();
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <raylib.h>
+
+// ============================================================================
+// INPUT
+// ============================================================================
+//
+// Everything the screens and elements read from raylib's input state goes
+// through here, so a session can be recorded and played back frame for frame
+// (see inputRecording.h).
+//
+// Live, the default, forwards every call straight to raylib. Record and
+// Replay answer from one InputFrame per loop iteration instead: Record takes
+// it from raylib with capture() at the top of the frame, Replay installs a
+// recorded one with play().
+//
+// Render thread only.
+
+// One loop iteration's worth of input, as far as the app reads it
+struct InputFrame {
+    double time = 0.0;            // GetTime() when the frame was captured
+    float frameTime = 0.0f;       // GetFrameTime()
+    std::vector<int> chars;       // GetCharPressed() queue, in order
+    std::vector<int> keysPressed; // every key IsKeyPressed() was true for
+    Vector2 mouse{0, 0};
+    Vector2 mouseDelta{0, 0};
+    float wheel = 0.0f;
+    uint8_t buttonsPressed = 0;   // bit per MouseButton
+    uint8_t buttonsDown = 0;
+    uint8_t buttonsReleased = 0;
+};
+
+struct Input {
+    enum class Mode { Live, Record, Replay };
+
+    static constexpr int MAX_KEY = 512; // raylib's MAX_KEYBOARD_KEYS
+    static constexpr int MOUSE_BUTTONS = 7;
+
+    static inline Mode mode = Mode::Live;
+    static inline InputFrame frame;
+
+    // Record: snapshot raylib's input for this iteration, once, before anything reads it
+    static const InputFrame& capture() {
+        frame = InputFrame{};
+        frame.time = GetTime();
+        frame.frameTime = GetFrameTime();
+
+        for (int c = GetCharPressed(); c > 0; c = GetCharPressed()) frame.chars.push_back(c);
+        for (int key = 1; key < MAX_KEY; ++key) {
+            if (IsKeyPressed(key)) frame.keysPressed.push_back(key);
+        }
+
+        frame.mouse = GetMousePosition();
+        frame.mouseDelta = GetMouseDelta();
+        frame.wheel = GetMouseWheelMove();
+        for (int button = 0; button < MOUSE_BUTTONS; ++button) {
+            auto bit = static_cast<uint8_t>(1u << button);
+            if (IsMouseButtonPressed(button)) frame.buttonsPressed |= bit;
+            if (IsMouseButtonDown(button)) frame.buttonsDown |= bit;
+            if (IsMouseButtonReleased(button)) frame.buttonsReleased |= bit;
+        }
+
+        nextChar = 0;
+        return frame;
+    }
+
+    // Replay: this iteration sees exactly what was recorded
+    static void play(InputFrame recorded) {
+        frame = std::move(recorded);
+        nextChar = 0;
+    }
+
+    // GetTime(), or when the frame was captured
+    static double time() { return mode == Mode::Live ? GetTime() : frame.time; }
+
+    static float frameTime() { return mode == Mode::Live ? GetFrameTime() : frame.frameTime; }
+
+    static int charPressed() {
+        if (mode == Mode::Live) return GetCharPressed();
+        return nextChar < frame.chars.size() ? frame.chars[nextChar++] : 0;
+    }
+
+    static bool keyPressed(int key) {
+        if (mode == Mode::Live) return IsKeyPressed(key);
+        for (int k : frame.keysPressed) {
+            if (k == key) return true;
+        }
+        return false;
+    }
+
+    static Vector2 mousePosition() { return mode == Mode::Live ? GetMousePosition() : frame.mouse; }
+    static Vector2 mouseDelta() { return mode == Mode::Live ? GetMouseDelta() : frame.mouseDelta; }
+    static float mouseWheelMove() { return mode == Mode::Live ? GetMouseWheelMove() : frame.wheel; }
+
+    static bool mouseButtonPressed(int button) {
+        return mode == Mode::Live ? IsMouseButtonPressed(button) : hasButton(frame.buttonsPressed, button);
+    }
+    static bool mouseButtonDown(int button) {
+        return mode == Mode::Live ? IsMouseButtonDown(button) : hasButton(frame.buttonsDown, button);
+    }
+    static bool mouseButtonReleased(int button) {
+        return mode == Mode::Live ? IsMouseButtonReleased(button) : hasButton(frame.buttonsReleased, button);
+    }
+
+private:
+    static inline size_t nextChar = 0;
+
+    static bool hasButton(uint8_t bits, int button) {
+        return button >= 0 && button < MOUSE_BUTTONS && (bits & (1u << button)) != 0;
+    }
+};
+
+#endif // INPUT_H
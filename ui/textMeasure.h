@@ -0,0 +1,305 @@
+#ifndef TEXT_MEASURE_H
+#define TEXT_MEASURE_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <raylib.h>
+
+// ============================================================================
+// TEXT MEASUREMENT CACHE
+// ============================================================================
+//
+// Drop-in replacement for MeasureTextEx/MeasureText, following raylib 5.5
+// (the version vcpkg-configuration.json pins): an empty string measures
+// {0, 0}, and a single line is the sum of glyph advances scaled to the size
+// plus spacing between glyphs.
+//
+// Every font gets a table of glyph advances, filled the first time a
+// codepoint is seen, so measuring a single line is a table lookup per
+// codepoint instead of raylib's linear glyph search. Whole strings are
+// additionally memoized by font, size, spacing and the string itself.
+//
+// width() measures any substring from the advance tables without touching
+// the string cache, which is what caret placement wants. Line wrapping walks
+// the text itself and reads single advances through advancesFor().
+//
+// Render thread only.
+
+struct TextMeasureStats {
+    unsigned long long hits = 0;       // whole-string lookups answered from the cache
+    unsigned long long misses = 0;
+    unsigned long long glyphMisses = 0; // advances that had to be looked up in the font
+    size_t cachedStrings = 0;
+    size_t fonts = 0;
+
+    [[nodiscard]] double hitRate() const {
+        unsigned long long total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+struct TextMeasure {
+private:
+    struct advanceTable;
+
+public:
+    static constexpr size_t MAX_CACHED_STRINGS = 16384;
+
+    static Vector2 measure(const Font& font, const char* text, float fontSize, float spacing) {
+        if (font.texture.id == 0 || text == nullptr) return {0, 0};
+        return measure(font, std::string_view(text), fontSize, spacing);
+    }
+
+    static Vector2 measure(const Font& font, std::string_view text, float fontSize, float spacing) {
+        if (font.texture.id == 0 || text.empty()) return {0, 0};
+
+        stringView key{fontKey(font), floatBits(fontSize), floatBits(spacing), text};
+        auto& cache = strings();
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            counters().hits++;
+            return it->second;
+        }
+        counters().misses++;
+
+        Vector2 size;
+        if (text.find('\n') != std::string_view::npos) {
+            // Line height depends on raylib's text line spacing, which cannot be read back
+            std::string copy(text);
+            size = MeasureTextEx(font, copy.c_str(), fontSize, spacing);
+        }
+        else {
+            size = {width(font, text, fontSize, spacing), fontSize};
+        }
+
+        if (cache.size() >= MAX_CACHED_STRINGS) cache.clear();
+        cache.emplace(stringKey{key.font, key.sizeBits, key.spacingBits, std::string(text)}, size);
+        return size;
+    }
+
+    // MeasureText() for raylib's default font
+    static int measureDefault(const char* text, int fontSize) {
+        Font font = GetFontDefault();
+        if (font.texture.id == 0) return 0;
+
+        constexpr int defaultFontSize = 10;
+        if (fontSize < defaultFontSize) fontSize = defaultFontSize;
+        int spacing = fontSize / defaultFontSize;
+        return static_cast<int>(measure(font, text, static_cast<float>(fontSize), static_cast<float>(spacing)).x);
+    }
+
+    // Width of a single line (no '\n') from the advance table alone.
+    // Matches MeasureTextEx(...).x for the same text, 0 for an empty one.
+    static float width(const Font& font, std::string_view text, float fontSize, float spacing) {
+        if (font.texture.id == 0 || text.empty()) return 0.0f;
+
+        advanceTable& table = tableFor(font);
+        float sum = 0.0f;
+        int count = 0;
+
+        for (size_t i = 0; i < text.size();) {
+            auto byte = static_cast<unsigned char>(text[i]);
+            if (byte < 0x80) {
+                sum += table.ascii[byte] >= 0.0f ? table.ascii[byte] : fillAscii(font, table, byte);
+                i++;
+            }
+            else {
+                size_t codepointSize = 1;
+                int codepoint = nextCodepoint(text, i, codepointSize);
+                sum += otherAdvance(font, table, codepoint);
+                i += codepointSize;
+            }
+            count++;
+        }
+
+        float scale = fontSize / static_cast<float>(font.baseSize);
+        return sum * scale + static_cast<float>(count - 1) * spacing;
+    }
+
+    // Unscaled advances of one font, looked up without finding its table again
+    // for every glyph. Sums of these scale and space exactly like width().
+    // Valid until the font is forgotten or the cache is cleared.
+    class GlyphAdvances {
+    public:
+        float operator()(int codepoint) const {
+            if (codepoint >= 0 && codepoint < 128) {
+                float cached = table->ascii[codepoint];
+                return cached >= 0.0f ? cached : fillAscii(font, *table, static_cast<unsigned char>(codepoint));
+            }
+            return otherAdvance(font, *table, codepoint);
+        }
+
+        [[nodiscard]] float scale(float fontSize) const { return fontSize / static_cast<float>(font.baseSize); }
+
+    private:
+        friend struct TextMeasure;
+        GlyphAdvances(const Font& f, advanceTable& t) : font(f), table(&t) {}
+
+        Font font;
+        advanceTable* table;
+    };
+
+    // The font must be loaded (texture id != 0)
+    static GlyphAdvances advancesFor(const Font& font) { return {font, tableFor(font)}; }
+
+    // GetCodepointNext() without reading past the end of the view: malformed
+    // or truncated sequences decode to '?' and consume one byte, as in raylib
+    static int nextCodepoint(std::string_view text, size_t i, size_t& codepointSize) {
+        auto at = [&](size_t k) -> int {
+            return i + k < text.size() ? static_cast<unsigned char>(text[i + k]) : 0;
+        };
+        auto continuation = [&](size_t k) { return (at(k) & 0xC0) == 0x80; };
+
+        int lead = at(0);
+        codepointSize = 1;
+        if (lead < 0x80) return lead;
+
+        if ((lead & 0xF8) == 0xF0) {
+            if (!continuation(1) || !continuation(2) || !continuation(3)) return '?';
+            codepointSize = 4;
+            return ((lead & 0x07) << 18) | ((at(1) & 0x3F) << 12) | ((at(2) & 0x3F) << 6) | (at(3) & 0x3F);
+        }
+        if ((lead & 0xF0) == 0xE0) {
+            if (!continuation(1) || !continuation(2)) return '?';
+            codepointSize = 3;
+            return ((lead & 0x0F) << 12) | ((at(1) & 0x3F) << 6) | (at(2) & 0x3F);
+        }
+        if ((lead & 0xE0) == 0xC0) {
+            if (!continuation(1)) return '?';
+            codepointSize = 2;
+            return ((lead & 0x1F) << 6) | (at(1) & 0x3F);
+        }
+        return '?';
+    }
+
+    // Drop everything known about a font that is being unloaded or rebuilt
+    static void forgetFont(const Font& font) {
+        tables().erase(fontKey(font));
+        strings().clear();
+    }
+
+    static void clear() {
+        tables().clear();
+        strings().clear();
+    }
+
+    static TextMeasureStats stats() {
+        TextMeasureStats result = counters();
+        result.cachedStrings = strings().size();
+        result.fonts = tables().size();
+        return result;
+    }
+
+    static void resetStats() { counters() = TextMeasureStats{}; }
+
+private:
+    struct advanceTable {
+        float ascii[128];
+        std::unordered_map<int, float> other;
+
+        advanceTable() {
+            for (float& a : ascii) a = -1.0f;
+        }
+    };
+
+    // Texture alone is not enough: a growing atlas keeps neither its glyph array nor its count
+    static uint64_t fontKey(const Font& font) {
+        uint64_t key = font.texture.id;
+        key = key * 1099511628211ULL ^ static_cast<uint64_t>(reinterpret_cast<uintptr_t>(font.glyphs));
+        key = key * 1099511628211ULL ^ static_cast<uint64_t>(font.glyphCount);
+        key = key * 1099511628211ULL ^ static_cast<uint64_t>(font.baseSize);
+        return key;
+    }
+
+    static uint32_t floatBits(float value) {
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // Whole-string cache key. The text is stored and compared, so two strings
+    // that happen to hash alike never share a size; lookups go through
+    // stringView and only a miss copies the text.
+    struct stringKey {
+        uint64_t font;
+        uint32_t sizeBits;
+        uint32_t spacingBits;
+        std::string text;
+    };
+
+    struct stringView {
+        uint64_t font;
+        uint32_t sizeBits;
+        uint32_t spacingBits;
+        std::string_view text;
+    };
+
+    struct stringKeyHash {
+        using is_transparent = void;
+
+        size_t operator()(const stringKey& key) const { return (*this)(stringView{key.font, key.sizeBits, key.spacingBits, key.text}); }
+
+        size_t operator()(const stringView& key) const {
+            uint64_t hash = std::hash<std::string_view>{}(key.text);
+            hash ^= key.font + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            hash ^= (static_cast<uint64_t>(key.sizeBits) << 32 | key.spacingBits) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    struct stringKeyEqual {
+        using is_transparent = void;
+
+        template <typename A, typename B>
+        bool operator()(const A& a, const B& b) const {
+            return a.font == b.font && a.sizeBits == b.sizeBits && a.spacingBits == b.spacingBits &&
+                   std::string_view(a.text) == std::string_view(b.text);
+        }
+    };
+
+    using stringCache = std::unordered_map<stringKey, Vector2, stringKeyHash, stringKeyEqual>;
+
+    // Same expression MeasureTextEx uses per glyph, before scaling
+    static float glyphAdvance(const Font& font, int codepoint) {
+        counters().glyphMisses++;
+        int index = GetGlyphIndex(font, codepoint);
+        if (font.glyphs[index].advanceX != 0) return static_cast<float>(font.glyphs[index].advanceX);
+        return font.recs[index].width + static_cast<float>(font.glyphs[index].offsetX);
+    }
+
+    static float fillAscii(const Font& font, advanceTable& table, unsigned char c) {
+        table.ascii[c] = glyphAdvance(font, c);
+        return table.ascii[c];
+    }
+
+    static float otherAdvance(const Font& font, advanceTable& table, int codepoint) {
+        auto it = table.other.find(codepoint);
+        if (it != table.other.end()) return it->second;
+        return table.other.emplace(codepoint, glyphAdvance(font, codepoint)).first->second;
+    }
+
+    static advanceTable& tableFor(const Font& font) {
+        return tables()[fontKey(font)];
+    }
+
+    static std::unordered_map<uint64_t, advanceTable>& tables() {
+        static std::unordered_map<uint64_t, advanceTable> instance;
+        return instance;
+    }
+
+    static stringCache& strings() {
+        static stringCache instance;
+        return instance;
+    }
+
+    static TextMeasureStats& counters() {
+        static TextMeasureStats instance;
+        return instance;
+    }
+};
+
+#endif // TEXT_MEASURE_H
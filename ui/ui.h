@@ -6,14 +6,19 @@
 #define UI_H
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <memory>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <raylib.h>
+#include <rlgl.h>
+#include "input.h"
+#include "textMeasure.h"
+#include "profiler.h"
 
 // ============================================================================
 // UTILITY STRUCTURES
@@ -54,6 +59,105 @@ struct Alignment {
     Alignment(Horizontal h, Vertical v) : hAlign(h), vAlign(v) {}
 };
 
+// ============================================================================
+// LAYOUT STATISTICS
+// ============================================================================
+
+// Counts Frame layout passes. A screen that is not changing should report
+// zero passes per frame once its first frame has been laid out.
+struct LayoutStats {
+    static inline int passesThisFrame = 0;
+    static inline int passesLastFrame = 0;
+    static inline unsigned long long totalPasses = 0;
+
+    // Call once at the top of every frame
+    static void beginFrame() {
+        passesLastFrame = passesThisFrame;
+        passesThisFrame = 0;
+    }
+
+    static void recordPass() {
+        passesThisFrame++;
+        totalPasses++;
+    }
+};
+
+// Counts what reaches raylib each frame: rectangles, text runs and cache
+// blits, plus how many cached frames had to be rendered again. A static
+// screen made of cached frames should draw a handful and render none.
+struct RenderStats {
+    static inline int drawsThisFrame = 0;
+    static inline int drawsLastFrame = 0;
+    static inline int cacheRendersThisFrame = 0;
+    static inline int cacheRendersLastFrame = 0;
+
+    // Call once at the top of every frame
+    static void beginFrame() {
+        drawsLastFrame = drawsThisFrame;
+        drawsThisFrame = 0;
+        cacheRendersLastFrame = cacheRendersThisFrame;
+        cacheRendersThisFrame = 0;
+    }
+
+    static void recordDraw() { drawsThisFrame++; }
+    static void recordCacheRender() { cacheRendersThisFrame++; }
+};
+
+// ============================================================================
+// RENDER CACHE
+// ============================================================================
+
+// Redirects drawing into a Frame's cache texture. Elements keep drawing in
+// screen coordinates; a camera maps them into the texture, and anything that
+// sets raw pixel state (the scissor rectangle) goes through here.
+//
+// raylib cannot nest texture modes, so a cached frame inside another one
+// draws straight into its ancestor's texture.
+struct RenderCache {
+    static inline int depth = 0;
+    static inline Vector2 origin{0, 0};
+
+    static void begin(const RenderTexture2D& target, Vector2 at) {
+        depth++;
+        origin = at;
+        RenderStats::recordCacheRender();
+
+        BeginTextureMode(target);
+        ClearBackground(BLANK);
+        BeginMode2D(Camera2D{{0, 0}, at, 0.0f, 1.0f});
+
+        // Leaves premultiplied colour in the texture, with alpha accumulating
+        // coverage instead of being multiplied by itself
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+                                  RL_FUNC_ADD, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    }
+
+    static void end() {
+        EndBlendMode();
+        EndMode2D();
+        EndTextureMode();
+        depth--;
+        origin = {0, 0};
+    }
+
+    static void blit(const RenderTexture2D& cache, Vector2 at) {
+        // Render textures are stored bottom-up
+        Rectangle source{0, 0, static_cast<float>(cache.texture.width), -static_cast<float>(cache.texture.height)};
+
+        BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(cache.texture, source, at, WHITE);
+        EndBlendMode();
+        RenderStats::recordDraw();
+    }
+
+    // BeginScissorMode() for a rectangle in screen coordinates
+    static void beginScissor(const Rectangle& area) {
+        BeginScissorMode(static_cast<int>(area.x - origin.x), static_cast<int>(area.y - origin.y),
+                         static_cast<int>(area.width), static_cast<int>(area.height));
+    }
+};
+
 // ============================================================================
 // BASE DRAWABLE ELEMENT
 // ============================================================================
@@ -61,6 +165,17 @@ struct Alignment {
 struct DrawElement {
     Rectangle bounds;
 
+    // Owning frame, set by Frame::AddChild
+    DrawElement* parent{nullptr};
+
+    // Set when something that affects layout changed. Frames only lay out
+    // their children again while it is set.
+    bool layoutDirty{true};
+
+    // Set when something that affects how the element looks changed. Cached
+    // frames only render their contents again while it is set.
+    bool paintDirty{true};
+
     DrawElement() : bounds{0, 0, 0, 0} {}
     explicit DrawElement(const Rectangle& rect) : bounds(rect) {}
     virtual ~DrawElement() = default;
@@ -69,10 +184,27 @@ struct DrawElement {
     virtual void update(Vector2 parentPos) { (void)parentPos; }
     virtual void updateBounds() {}
 
+    // Flags this element and every frame above it for layout on the next update or draw.
+    // Needed after writing to bounds directly once the element has been laid out.
+    void markDirty() {
+        for (DrawElement* element = this; element; element = element->parent) {
+            element->layoutDirty = true;
+            element->paintDirty = true;
+        }
+    }
+
+    // Flags every cached frame above this element for repainting. Enough for
+    // changes that do not move anything, like a colour or a hover state.
+    void invalidate() {
+        for (DrawElement* element = this; element; element = element->parent) {
+            element->paintDirty = true;
+        }
+    }
+
     // Helper methods
     [[nodiscard]] Vector2 getSize() const { return {bounds.width, bounds.height}; }
-    void setPosition(float x, float y) { bounds.x = x; bounds.y = y; }
-    void setSize(float width, float height) { bounds.width = width; bounds.height = height; }
+    void setPosition(float x, float y) { bounds.x = x; bounds.y = y; markDirty(); }
+    void setSize(float width, float height) { bounds.width = width; bounds.height = height; markDirty(); }
 };
 
 // ============================================================================
@@ -90,7 +222,14 @@ struct TextElement : DrawElement {
     float wrapLength = 0.0f;
 
     // Text wrapping properties
-    std::vector<std::string> lines;
+    struct TextLine {
+        size_t begin = 0;          // byte range of txt
+        size_t end = 0;
+        float width = 0.0f;
+        bool hyphenated = false;   // ends at a soft hyphen, drawn as '-'
+    };
+
+    std::vector<TextLine> lines;
     float lineSpacing = 5.0f;
     float characterSpacing = 1.0f;
 
@@ -113,11 +252,13 @@ struct TextElement : DrawElement {
             } else {
                 calculateBounds();
             }
+            markDirty();
         }
     }
 
     void setColor(Color newColor) {
         color = newColor;
+        invalidate();
     }
 
     void setFont(const Font& newFont) {
@@ -128,50 +269,108 @@ struct TextElement : DrawElement {
         } else {
             calculateBounds();
         }
+        markDirty();
     }
 
+    // Greedy wrapping in a single pass over the UTF-8 text. Glyph advances are
+    // summed as the pass goes, so no line is ever measured twice, and lines are
+    // kept as byte ranges of txt rather than copies.
+    //
+    // Lines break at whitespace (a run of it counts as one space), after a
+    // hyphen, or at a soft hyphen (U+00AD), which is drawn as '-' only when a
+    // line ends there. A word wider than wrapLength gets a line of its own.
     void wrap_text() {
         if (!useWrapText || wrapLength <= 0) return;
+        PROFILE_SCOPE("TextElement::wrap_text");
 
         lines.clear();
-        std::istringstream words(txt);
-        std::string word;
-        std::string currentLine;
         bounds.width = 0;
 
-        auto measureLineWidth = [this](const std::string& line) -> float {
-            if (useCustomFont) {
-                return MeasureTextEx(font, line.c_str(), static_cast<float>(fontSize), characterSpacing).x;
-            }
-            return static_cast<float>(MeasureText(line.c_str(), fontSize));
-        };
-
-        while (words >> word) {
-            std::string testLine = currentLine.empty() ? word : currentLine + " " + word;
-            float testWidth = measureLineWidth(testLine);
-
-            if (testWidth <= wrapLength || currentLine.empty()) {
-                currentLine = testLine;
-            }
-            else {
-                if (!currentLine.empty()) {
-                    lines.push_back(currentLine);
-                    bounds.width = std::max(bounds.width, measureLineWidth(currentLine));
+        TextStyle style = resolveStyle();
+        if (style.font.texture.id != 0) {
+            TextMeasure::GlyphAdvances advance = TextMeasure::advancesFor(style.font);
+            const float scale = advance.scale(style.size);
+            const float spaceAdvance = advance(' ');
+            const float hyphenAdvance = advance('-');
+
+            auto widthOf = [&](float sum, int count) {
+                if (count == 0) return 0.0f;
+                float width = sum * scale + static_cast<float>(count - 1) * style.spacing;
+                return style.wholePixels ? static_cast<float>(static_cast<int>(width)) : width;
+            };
+
+            // Open line, up to the end of the last piece placed on it
+            TextLine line;
+            float lineSum = 0.0f;
+            int lineCount = 0;
+
+            // Piece of a word between two break opportunities
+            size_t pieceBegin = 0;
+            float pieceSum = 0.0f;
+            int pieceCount = 0;
+            bool gapBefore = false;
+            bool softBefore = false;
+
+            auto closeLine = [&](bool hyphenated) {
+                line.hyphenated = hyphenated;
+                line.width = hyphenated ? widthOf(lineSum + hyphenAdvance, lineCount + 1) : widthOf(lineSum, lineCount);
+                bounds.width = std::max(bounds.width, line.width);
+                lines.push_back(line);
+                lineSum = 0.0f;
+                lineCount = 0;
+            };
+
+            auto placePiece = [&](size_t pieceEnd) {
+                if (pieceCount == 0) return;
+
+                if (lineCount > 0) {
+                    float sum = lineSum + pieceSum + (gapBefore ? spaceAdvance : 0.0f);
+                    int count = lineCount + pieceCount + (gapBefore ? 1 : 0);
+                    if (widthOf(sum, count) <= wrapLength) {
+                        lineSum = sum;
+                        lineCount = count;
+                        line.end = pieceEnd;
+                    }
+                    else {
+                        closeLine(softBefore && !gapBefore);
+                    }
                 }
+                if (lineCount == 0) {
+                    line.begin = pieceBegin;
+                    line.end = pieceEnd;
+                    lineSum = pieceSum;
+                    lineCount = pieceCount;
+                }
+
+                pieceSum = 0.0f;
+                pieceCount = 0;
+                gapBefore = false;
+                softBefore = false;
+            };
 
-                currentLine = word;
+            for (size_t i = 0; i < txt.size();) {
+                size_t codepointSize = 1;
+                int codepoint = TextMeasure::nextCodepoint(txt, i, codepointSize);
 
-                if (measureLineWidth(currentLine) > wrapLength) {
-                    lines.push_back(currentLine);
-                    bounds.width = std::max(bounds.width, measureLineWidth(currentLine));
-                    currentLine.clear();
+                if (isWrapSpace(codepoint)) {
+                    placePiece(i);
+                    gapBefore = true;
                 }
+                else if (codepoint == SOFT_HYPHEN) {
+                    placePiece(i);
+                    softBefore = true;
+                }
+                else {
+                    if (pieceCount == 0) pieceBegin = i;
+                    pieceSum += advance(codepoint);
+                    pieceCount++;
+                    if (codepoint == '-') placePiece(i + codepointSize);
+                }
+                i += codepointSize;
             }
-        }
 
-        if (!currentLine.empty()) {
-            lines.push_back(currentLine);
-            bounds.width = std::max(bounds.width, measureLineWidth(currentLine));
+            placePiece(txt.size());
+            if (lineCount > 0) closeLine(false);
         }
 
         if (!lines.empty()) {
@@ -183,6 +382,11 @@ struct TextElement : DrawElement {
         }
     }
 
+    [[nodiscard]] std::string_view lineText(size_t index) const {
+        const TextLine& line = lines[index];
+        return std::string_view(txt).substr(line.begin, line.end - line.begin);
+    }
+
     void draw(Vector2 parentPos) override {
         Vector2 drawPos = {
             parentPos.x + bounds.x + offset.x,
@@ -190,23 +394,15 @@ struct TextElement : DrawElement {
         };
 
         if (useWrapText && !lines.empty()) {
+            TextStyle style = resolveStyle();
             for (size_t i = 0; i < lines.size(); i++) {
                 Vector2 linePos = {
                     drawPos.x,
                     drawPos.y + static_cast<float>(i) * (static_cast<float>(fontSize) + lineSpacing)
                 };
 
-                if (useCustomFont) {
-                    DrawTextEx(font, lines[i].c_str(), linePos,
-                        static_cast<float>(fontSize), characterSpacing, color);
-                }
-                else {
-                    DrawText(lines[i].c_str(),
-                        static_cast<int>(linePos.x),
-                        static_cast<int>(linePos.y),
-                        fontSize,
-                        color);
-                }
+                drawLine(style, lines[i], linePos);
+                RenderStats::recordDraw();
             }
         }
         else {
@@ -221,6 +417,7 @@ struct TextElement : DrawElement {
                     fontSize,
                     color);
             }
+            RenderStats::recordDraw();
         }
     }
 
@@ -234,15 +431,69 @@ struct TextElement : DrawElement {
     }
 
 private:
+    static constexpr int SOFT_HYPHEN = 0x00AD;
+
+    // What DrawText resolves to for the default font: a minimum size of 10,
+    // spacing of a tenth of the size and whole-pixel positions and widths
+    struct TextStyle {
+        Font font;
+        float size;
+        float spacing;
+        bool wholePixels;
+    };
+
+    [[nodiscard]] TextStyle resolveStyle() const {
+        if (useCustomFont) return {font, static_cast<float>(fontSize), characterSpacing, false};
+
+        int size = std::max(fontSize, 10);
+        return {GetFontDefault(), static_cast<float>(size), static_cast<float>(size / 10), true};
+    }
+
+    // Whitespace as std::isspace sees it in the C locale
+    static bool isWrapSpace(int codepoint) {
+        return codepoint == ' ' || (codepoint >= '\t' && codepoint <= '\r');
+    }
+
+    // DrawTextEx for one line: whitespace runs collapse to a single space and
+    // soft hyphens are skipped, matching the widths wrap_text measured
+    void drawLine(const TextStyle& style, const TextLine& line, Vector2 pos) const {
+        if (style.wholePixels) {
+            pos = {static_cast<float>(static_cast<int>(pos.x)), static_cast<float>(static_cast<int>(pos.y))};
+        }
+
+        TextMeasure::GlyphAdvances advance = TextMeasure::advancesFor(style.font);
+        const float scale = advance.scale(style.size);
+        bool afterSpace = false;
+
+        for (size_t i = line.begin; i < line.end;) {
+            size_t codepointSize = 1;
+            int codepoint = TextMeasure::nextCodepoint(txt, i, codepointSize);
+            i += codepointSize;
+
+            if (isWrapSpace(codepoint)) {
+                if (!afterSpace) pos.x += advance(' ') * scale + style.spacing;
+                afterSpace = true;
+                continue;
+            }
+            afterSpace = false;
+            if (codepoint == SOFT_HYPHEN) continue;
+
+            DrawTextCodepoint(style.font, codepoint, pos, style.size, color);
+            pos.x += advance(codepoint) * scale + style.spacing;
+        }
+
+        if (line.hyphenated) DrawTextCodepoint(style.font, '-', pos, style.size, color);
+    }
+
     void calculateBounds() {
         if (useCustomFont) {
-            Vector2 size = MeasureTextEx(font, txt.c_str(),
+            Vector2 size = TextMeasure::measure(font, txt,
                 static_cast<float>(fontSize), characterSpacing);
             bounds.width = size.x;
             bounds.height = size.y;
         }
         else {
-            bounds.width = static_cast<float>(MeasureText(txt.c_str(), fontSize));
+            bounds.width = static_cast<float>(TextMeasure::measureDefault(txt.c_str(), fontSize));
             bounds.height = static_cast<float>(fontSize);
         }
     }
@@ -310,7 +561,7 @@ struct ButtonElement : DrawElement {
     static std::unique_ptr<ButtonElement> createAutoSize(const std::string& text, int fontSize = 20, 
                                                          const Padding& padding = Padding(10.0f, 20.0f),
                                                          std::function<void()> callback = nullptr) {
-        float textWidth = static_cast<float>(MeasureText(text.c_str(), fontSize));
+        float textWidth = static_cast<float>(TextMeasure::measureDefault(text.c_str(), fontSize));
         float width = textWidth + padding.totalHorizontal();
         float height = static_cast<float>(fontSize) + padding.totalVertical();
         
@@ -324,6 +575,7 @@ struct ButtonElement : DrawElement {
     void setLabel(const std::string& newLabel) {
         label = newLabel;
         calculateTextOffset();
+        invalidate();
     }
 
     void setEnabled(bool enabled) {
@@ -334,6 +586,7 @@ struct ButtonElement : DrawElement {
         else if (currentState == State::Disabled) {
             currentState = State::Normal;
         }
+        invalidate();
     }
 
     void setCallback(std::function<void()> callback) {
@@ -341,6 +594,48 @@ struct ButtonElement : DrawElement {
     }
 
     void update(Vector2 parentPos) override {
+        State previous = currentState;
+        updateState(parentPos);
+
+        // Hover and press colours are all that changes from frame to frame
+        if (currentState != previous) invalidate();
+    }
+
+    void draw(Vector2 parentPos) override {
+        Rectangle drawRect = {
+            parentPos.x + bounds.x,
+            parentPos.y + bounds.y,
+            bounds.width,
+            bounds.height
+        };
+
+        Color bgColor = getBackgroundColor();
+        DrawRectangleRounded(drawRect, style.cornerRadius / bounds.height, 8, bgColor);
+        RenderStats::recordDraw();
+
+        if (style.borderThickness > 0) {
+            DrawRectangleRoundedLines(drawRect, style.cornerRadius / bounds.height, 8, style.borderColor);
+            RenderStats::recordDraw();
+        }
+
+        Color textColor = getTextColor();
+        Vector2 textPos = {
+            drawRect.x + textOffset.x,
+            drawRect.y + textOffset.y
+        };
+
+        if (useCustomFont) {
+            DrawTextEx(font, label.c_str(), textPos, static_cast<float>(fontSize), 1.0f, textColor);
+        }
+        else {
+            DrawText(label.c_str(), static_cast<int>(textPos.x), static_cast<int>(textPos.y), 
+                    fontSize, textColor);
+        }
+        RenderStats::recordDraw();
+    }
+
+private:
+    void updateState(Vector2 parentPos) {
         if (!isEnabled) {
             currentState = State::Disabled;
             wasPressed = false;
@@ -354,11 +649,11 @@ struct ButtonElement : DrawElement {
             bounds.height
         };
 
-        Vector2 mousePos = GetMousePosition();
+        Vector2 mousePos = Input::mousePosition();
         bool isHovered = CheckCollisionPointRec(mousePos, absoluteBounds);
-        bool isMousePressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
-        bool isMouseDown = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
-        bool isMouseReleased = IsMouseButtonReleased(MOUSE_LEFT_BUTTON);
+        bool isMousePressed = Input::mouseButtonPressed(MOUSE_LEFT_BUTTON);
+        bool isMouseDown = Input::mouseButtonDown(MOUSE_LEFT_BUTTON);
+        bool isMouseReleased = Input::mouseButtonReleased(MOUSE_LEFT_BUTTON);
 
         if (isHovered && isMousePressed) {
             wasPressed = true;
@@ -382,41 +677,10 @@ struct ButtonElement : DrawElement {
         }
     }
 
-    void draw(Vector2 parentPos) override {
-        Rectangle drawRect = {
-            parentPos.x + bounds.x,
-            parentPos.y + bounds.y,
-            bounds.width,
-            bounds.height
-        };
-
-        Color bgColor = getBackgroundColor();
-        DrawRectangleRounded(drawRect, style.cornerRadius / bounds.height, 8, bgColor);
-
-        if (style.borderThickness > 0) {
-            DrawRectangleRoundedLines(drawRect, style.cornerRadius / bounds.height, 8, style.borderColor);
-        }
-
-        Color textColor = getTextColor();
-        Vector2 textPos = {
-            drawRect.x + textOffset.x,
-            drawRect.y + textOffset.y
-        };
-
-        if (useCustomFont) {
-            DrawTextEx(font, label.c_str(), textPos, static_cast<float>(fontSize), 1.0f, textColor);
-        }
-        else {
-            DrawText(label.c_str(), static_cast<int>(textPos.x), static_cast<int>(textPos.y), 
-                    fontSize, textColor);
-        }
-    }
-
-private:
     void calculateTextOffset() {
         float textWidth = useCustomFont ? 
-            MeasureTextEx(font, label.c_str(), static_cast<float>(fontSize), 1.0f).x :
-            static_cast<float>(MeasureText(label.c_str(), fontSize));
+            TextMeasure::measure(font, label, static_cast<float>(fontSize), 1.0f).x :
+            static_cast<float>(TextMeasure::measureDefault(label.c_str(), fontSize));
         
         textOffset.x = (bounds.width - textWidth) * 0.5f;
         textOffset.y = (bounds.height - static_cast<float>(fontSize)) * 0.5f;
@@ -458,6 +722,21 @@ struct Frame : DrawElement {
     std::vector<std::unique_ptr<DrawElement>> Children;
     Rectangle drawArea;
 
+    // Results of the last layout pass, read by update() and draw().
+    // childPositions[i] is where Children[i] goes.
+    Rectangle frameRect{0, 0, 0, 0};  // absolute bounds minus margin
+    std::vector<Vector2> childPositions;
+    Vector2 laidOutAt{0, 0};
+
+    // Render this frame and everything in it into a texture once, then draw
+    // only that texture until something inside calls markDirty() or
+    // invalidate(). Worth it for subtrees that rarely change. Children are
+    // clipped to the frame, and writing to a field directly (color, say)
+    // needs an invalidate() to show up.
+    bool cacheContents{false};
+    RenderTexture2D cache{};
+    Vector2 cachedAt{0, 0};
+
     Frame(Rectangle rect, Color c = LIGHTGRAY, Padding p = {},
           Margin m = {}, Alignment a = {})
         : DrawElement(rect), color(c), padding(p), margin(m), align(a),
@@ -469,7 +748,9 @@ struct Frame : DrawElement {
           } {
     }
 
-    ~Frame() override = default;
+    ~Frame() override {
+        if (cache.id != 0) UnloadRenderTexture(cache);
+    }
 
     Rectangle getDrawArea(Vector2 parentPos) {
         drawArea = {
@@ -483,7 +764,9 @@ struct Frame : DrawElement {
 
     void AddChild(std::unique_ptr<DrawElement> child) {
         if (child) {
+            child->parent = this;
             Children.push_back(std::move(child));
+            markDirty();
         }
     }
 
@@ -497,6 +780,8 @@ struct Frame : DrawElement {
 
         std::unique_ptr<DrawElement> removed = std::move(Children[index]);
         Children.erase(Children.begin() + static_cast<long>(index));
+        removed->parent = nullptr;
+        markDirty();
         return removed;
     }
 
@@ -510,6 +795,8 @@ struct Frame : DrawElement {
         if (it != Children.end()) {
             std::unique_ptr<DrawElement> removed = std::move(*it);
             Children.erase(it);
+            removed->parent = nullptr;
+            markDirty();
             return removed;
         }
         return nullptr;
@@ -519,6 +806,7 @@ struct Frame : DrawElement {
     void deleteChild(size_t index) {
         if (index < Children.size()) {
             Children.erase(Children.begin() + static_cast<long>(index));
+            markDirty();
         }
     }
 
@@ -530,11 +818,13 @@ struct Frame : DrawElement {
         
         if (it != Children.end()) {
             Children.erase(it);
+            markDirty();
         }
     }
 
     void clearChildren() {
         Children.clear();
+        markDirty();
     }
 
     [[nodiscard]] DrawElement* getChild(size_t index) const {
@@ -549,56 +839,102 @@ struct Frame : DrawElement {
     }
 
     void update(Vector2 parentPos) override {
-        Rectangle frameBounds = {
-            parentPos.x + bounds.x + margin.left,
-            parentPos.y + bounds.y + margin.top,
-            bounds.width - margin.totalHorizontal(),
-            bounds.height - margin.totalVertical()
-        };
+        layoutIfNeeded(parentPos);
 
-        if (layoutMode == Layout::Overlay) {
-            for (auto& child : Children) {
-                child->update({
-                    frameBounds.x + child->bounds.x,
-                    frameBounds.y + child->bounds.y
-                });
-            }
+        for (size_t i = 0; i < Children.size() && i < childPositions.size(); ++i) {
+            Children[i]->update(childPositions[i]);
+        }
+    }
+
+    void draw(Vector2 parentPos) override {
+        // update() may have changed something since the last pass
+        layoutIfNeeded(parentPos);
+
+        if (cacheContents && RenderCache::depth == 0) {
+            drawCached();
         }
         else {
-            processStackedChildren(parentPos, true);
+            drawContents();
         }
     }
 
-    void draw(Vector2 parentPos) override {
-        Rectangle frameBounds = {
+    // Recomputes the cached rectangles when this frame is dirty or has moved.
+    // Virtual, so a layout pass through a Frame& still gets e.g. ScrollFrame's.
+    virtual void layoutIfNeeded(Vector2 parentPos) {
+        bool moved = parentPos.x != laidOutAt.x || parentPos.y != laidOutAt.y;
+        if (!layoutDirty && !moved && childPositions.size() == Children.size()) return;
+
+        PROFILE_SCOPE("Frame::layout");
+        LayoutStats::recordPass();
+        laidOutAt = parentPos;
+        layoutDirty = false;
+
+        frameRect = {
             parentPos.x + bounds.x + margin.left,
             parentPos.y + bounds.y + margin.top,
             bounds.width - margin.totalHorizontal(),
             bounds.height - margin.totalVertical()
         };
-        DrawRectangleRec(frameBounds, color);
-
-        if (Children.empty()) return;
 
+        childPositions.resize(Children.size());
         if (layoutMode == Layout::Overlay) {
-            drawOverlayChildren(frameBounds);
+            layoutOverlayChildren();
         }
         else {
-            processStackedChildren(parentPos, false);
+            layoutStackedChildren(parentPos);
         }
     }
 
 private:
-    void drawOverlayChildren(const Rectangle& frameBounds) {
-        for (auto& child : Children) {
-            child->draw({
-                frameBounds.x + child->bounds.x,
-                frameBounds.y + child->bounds.y
-            });
+    void drawContents() {
+        if (color.a > 0) {
+            DrawRectangleRec(frameRect, color);
+            RenderStats::recordDraw();
+        }
+
+        for (size_t i = 0; i < Children.size() && i < childPositions.size(); ++i) {
+            Children[i]->draw(childPositions[i]);
+        }
+    }
+
+    void drawCached() {
+        // Whole pixels, so the texture maps 1:1 onto the screen
+        Vector2 origin{std::floor(frameRect.x), std::floor(frameRect.y)};
+        int width = static_cast<int>(std::ceil(frameRect.x + frameRect.width) - origin.x);
+        int height = static_cast<int>(std::ceil(frameRect.y + frameRect.height) - origin.y);
+        if (width <= 0 || height <= 0) return;
+
+        if (cache.id == 0 || cache.texture.width != width || cache.texture.height != height) {
+            if (cache.id != 0) UnloadRenderTexture(cache);
+            cache = LoadRenderTexture(width, height);
+            paintDirty = true;
+        }
+
+        // A sub-pixel move changes how the contents land on the pixel grid
+        if (frameRect.x != cachedAt.x || frameRect.y != cachedAt.y) paintDirty = true;
+
+        if (paintDirty) {
+            RenderCache::begin(cache, origin);
+            drawContents();
+            RenderCache::end();
+
+            cachedAt = {frameRect.x, frameRect.y};
+            paintDirty = false;
+        }
+
+        RenderCache::blit(cache, origin);
+    }
+
+    void layoutOverlayChildren() {
+        for (size_t i = 0; i < Children.size(); ++i) {
+            childPositions[i] = {
+                frameRect.x + Children[i]->bounds.x,
+                frameRect.y + Children[i]->bounds.y
+            };
         }
     }
 
-    void processStackedChildren(Vector2 parentPos, bool isUpdate) {
+    void layoutStackedChildren(Vector2 parentPos) {
         Rectangle contentArea = getDrawArea(parentPos);
         float currentX = contentArea.x;
         float currentY = contentArea.y;
@@ -611,8 +947,7 @@ private:
                 child->updateBounds();
             }
 
-            Vector2 childPos = calculateChildPosition(child.get(), contentArea, currentX, currentY);
-            isUpdate ? child->update(childPos) : child->draw(childPos);
+            childPositions[i] = calculateChildPosition(child.get(), contentArea, currentX, currentY);
 
             updateStackPosition(child.get(), currentX, currentY, i < Children.size() - 1);
         }
@@ -662,6 +997,255 @@ private:
     }
 };
 
+// ============================================================================
+// SCROLL FRAME - Virtualized vertical list
+// ============================================================================
+//
+// A vertical list that only lays out, updates and draws the children inside
+// its viewport plus a few on either side, clipped with a scissor rectangle.
+// Per-frame cost depends on how many children fit on screen, not on how many
+// there are.
+//
+// Heights are kept in a Fenwick tree, so finding the first visible child and
+// adjusting one height are both O(log n). A child that still has no width
+// (a TextElement waiting to be wrapped, say) counts as estimatedItemHeight
+// until it first scrolls into view; when such a child above the viewport
+// turns out taller or shorter, the scroll position moves with it so the
+// visible content stays put.
+
+struct ScrollFrame : Frame {
+    float estimatedItemHeight{40.0f};
+    size_t overscanItems{2};
+    float wheelStep{120.0f};      // pixels per wheel notch
+    float smoothing{18.0f};       // higher settles faster
+    Color scrollbarColor{Color{255, 255, 255, 60}};
+
+    ScrollFrame(Rectangle rect, Color c = BLANK, Padding p = {}, Margin m = {})
+        : Frame(rect, c, p, m) {
+        layoutMode = Layout::Vertical;
+    }
+
+    [[nodiscard]] float getScroll() const { return scroll; }
+    [[nodiscard]] float getContentHeight() const { return contentHeight(); }
+    [[nodiscard]] bool isScrolling() const { return scroll != targetScroll; }
+
+    // Visible children, including overscan, as of the last layout pass
+    [[nodiscard]] size_t firstVisible() const { return visibleBegin; }
+    [[nodiscard]] size_t visibleCount() const { return visibleEnd - visibleBegin; }
+
+    void scrollBy(float delta) {
+        targetScroll = clampScroll(targetScroll + delta);
+    }
+
+    void scrollTo(float offset, bool animate = true) {
+        targetScroll = clampScroll(offset);
+        if (!animate) {
+            scroll = targetScroll;
+            layoutDirty = true;
+            invalidate();
+        }
+    }
+
+    void update(Vector2 parentPos) override {
+        float wheel = Input::mouseWheelMove();
+        if (wheel != 0.0f && CheckCollisionPointRec(Input::mousePosition(), viewport)) {
+            scrollBy(-wheel * wheelStep);
+        }
+
+        if (scroll != targetScroll) {
+            // The first frame after an idle wait reports the whole wait as its frame time
+            float frameTime = std::min(Input::frameTime(), 1.0f / 30.0f);
+            float step = 1.0f - std::exp(-smoothing * frameTime);
+            scroll += (targetScroll - scroll) * step;
+            if (std::fabs(targetScroll - scroll) < 0.5f) scroll = targetScroll;
+
+            // Only this frame's children move; frames above need a repaint, not a layout
+            layoutDirty = true;
+            invalidate();
+        }
+
+        layoutIfNeeded(parentPos);
+
+        // Overscan children are laid out ahead of time but clipped away, so
+        // they must not take hover or clicks
+        for (size_t i = visibleBegin; i < visibleEnd; ++i) {
+            float top = childPositions[i].y;
+            if (top + heights[i] <= viewport.y || top >= viewport.y + viewport.height) continue;
+            Children[i]->update(childPositions[i]);
+        }
+    }
+
+    void draw(Vector2 parentPos) override {
+        layoutIfNeeded(parentPos);
+
+        if (color.a > 0) {
+            DrawRectangleRec(frameRect, color);
+            RenderStats::recordDraw();
+        }
+
+        RenderCache::beginScissor(viewport);
+        for (size_t i = visibleBegin; i < visibleEnd; ++i) {
+            Children[i]->draw(childPositions[i]);
+        }
+        EndScissorMode();
+
+        drawScrollbar();
+    }
+
+    // Same indexing as Frame, but only [firstVisible(), firstVisible() + visibleCount())
+    // hold positions from this pass
+    void layoutIfNeeded(Vector2 parentPos) override {
+        bool moved = parentPos.x != laidOutAt.x || parentPos.y != laidOutAt.y;
+        if (!layoutDirty && !moved && heights.size() == Children.size()) return;
+
+        PROFILE_SCOPE("ScrollFrame::layout");
+        LayoutStats::recordPass();
+        laidOutAt = parentPos;
+        layoutDirty = false;
+
+        frameRect = {
+            parentPos.x + bounds.x + margin.left,
+            parentPos.y + bounds.y + margin.top,
+            bounds.width - margin.totalHorizontal(),
+            bounds.height - margin.totalVertical()
+        };
+        viewport = getDrawArea(parentPos);
+
+        if (heights.size() != Children.size() || builtSpacing != spacing) rebuildHeights();
+        scroll = clampScroll(scroll);
+        targetScroll = clampScroll(targetScroll);
+
+        visibleBegin = visibleEnd = 0;
+        childPositions.resize(Children.size());
+        if (Children.empty()) {
+            scroll = targetScroll = 0.0f;
+            return;
+        }
+
+        size_t first = indexAt(scroll);
+        visibleBegin = first > overscanItems ? first - overscanItems : 0;
+
+        // Children above the one at the top edge push it around if their height changes
+        for (size_t i = visibleBegin; i < first; ++i) {
+            float delta = measure(i);
+            scroll += delta;
+            targetScroll += delta;
+        }
+
+        float bottom = scroll + viewport.height;
+        float top = static_cast<float>(prefix(visibleBegin));
+        size_t extra = 0;
+        size_t i = visibleBegin;
+
+        for (; i < Children.size(); ++i) {
+            if (top >= bottom && extra++ == overscanItems) break;
+            measure(i);
+            childPositions[i] = {viewport.x, viewport.y + top - scroll};
+            top += heights[i] + spacing;
+        }
+        visibleEnd = i;
+
+        // Measuring may have shrunk the content under the current position
+        if (clampScroll(scroll) != scroll) {
+            layoutDirty = true;
+            layoutIfNeeded(parentPos);
+        }
+    }
+
+private:
+    Rectangle viewport{0, 0, 0, 0};
+    float scroll{0.0f};
+    float targetScroll{0.0f};
+    size_t visibleBegin{0};
+    size_t visibleEnd{0};
+
+    // heights[i] is the child's height; the tree holds height + spacing per child
+    std::vector<float> heights;
+    std::vector<double> tree;
+    float builtSpacing{0.0f};
+
+    void rebuildHeights() {
+        builtSpacing = spacing;
+        heights.assign(Children.size(), estimatedItemHeight);
+
+        // Children that already have a size keep it; only pending ones are estimated
+        for (size_t i = 0; i < Children.size(); ++i) {
+            if (Children[i]->bounds.width > 0.0f) heights[i] = Children[i]->bounds.height;
+        }
+
+        // O(n) Fenwick construction
+        tree.assign(Children.size() + 1, 0.0);
+        for (size_t i = 1; i <= Children.size(); ++i) {
+            tree[i] += heights[i - 1] + spacing;
+            size_t next = i + (i & (~i + 1));
+            if (next <= Children.size()) tree[next] += tree[i];
+        }
+    }
+
+    // Lays the child out if it has never been and returns how much its height changed
+    float measure(size_t index) {
+        DrawElement* child = Children[index].get();
+        if (child->bounds.width <= 0.0f) {
+            child->bounds.width = viewport.width;
+            child->updateBounds();
+        }
+
+        float delta = child->bounds.height - heights[index];
+        if (delta != 0.0f) {
+            heights[index] = child->bounds.height;
+            for (size_t i = index + 1; i < tree.size(); i += i & (~i + 1)) tree[i] += delta;
+        }
+        return delta;
+    }
+
+    // Sum of height + spacing over the first count children
+    [[nodiscard]] double prefix(size_t count) const {
+        double sum = 0.0;
+        for (size_t i = count; i > 0; i -= i & (~i + 1)) sum += tree[i];
+        return sum;
+    }
+
+    // Child whose slot (height plus the spacing after it) contains offset y
+    [[nodiscard]] size_t indexAt(float y) const {
+        size_t index = 0;
+        double remaining = y;
+        size_t step = 1;
+        while (step * 2 < tree.size()) step *= 2;
+
+        for (; step > 0; step /= 2) {
+            if (index + step < tree.size() && tree[index + step] <= remaining) {
+                index += step;
+                remaining -= tree[index];
+            }
+        }
+        return std::min(index, Children.size() - 1);
+    }
+
+    [[nodiscard]] float contentHeight() const {
+        if (heights.empty()) return 0.0f;
+        return static_cast<float>(prefix(heights.size())) - spacing;
+    }
+
+    [[nodiscard]] float clampScroll(float offset) const {
+        float maxScroll = std::max(0.0f, contentHeight() - viewport.height);
+        return std::clamp(offset, 0.0f, maxScroll);
+    }
+
+    void drawScrollbar() const {
+        float content = contentHeight();
+        if (content <= viewport.height || viewport.height <= 0.0f) return;
+
+        constexpr float barWidth = 6.0f;
+        float thumbHeight = std::max(24.0f, viewport.height * viewport.height / content);
+        float travel = viewport.height - thumbHeight;
+        float thumbY = viewport.y + travel * (scroll / (content - viewport.height));
+
+        Rectangle thumb{viewport.x + viewport.width - barWidth, thumbY, barWidth, thumbHeight};
+        DrawRectangleRounded(thumb, 1.0f, 4, scrollbarColor);
+        RenderStats::recordDraw();
+    }
+};
+
 // ============================================================================
 // SPACER ELEMENT
 // ============================================================================